@@ -1,5 +1,27 @@
 #include "changes-vtab.h"
 
+/*
+** Performance notes for large sync fan-in (this C file is a thin shim;
+** the query construction and merge logic live in rs/core):
+**
+** - Delta pulls by version are already indexed: bootstrap.rs creates
+**   <table>__crsql_clock_dbv_idx on (db_version) for every clock
+**   table, and the db_vrsn constraint that xBestIndex forwards into
+**   the generated UNION ALL is pushed down into each arm by SQLite's
+**   flattener, so a "since version V" poll seeks per table rather
+**   than scanning.
+**
+** - Bulk apply through INSERT INTO crsql_changes runs one merge_insert
+**   per row against cached persistent statements (rs/core/stmt_cache).
+**   Sorting a large incoming batch by (table, pk) before insertion is
+**   worthwhile and can be done by the caller today (ORDER BY on the
+**   sending side); replacing the per-row clock probes with a single
+**   merged-cursor pass would need the merge decision (cl/col_version
+**   causal comparisons) restructured as a streaming join inside
+**   rs/core/changes_vtab_write.rs - a Rust-side redesign, not a vtab
+**   shim change.
+*/
+
 #include <assert.h>
 #include <stdint.h>
 #include <string.h>
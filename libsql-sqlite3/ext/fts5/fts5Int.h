@@ -209,6 +209,11 @@ struct Fts5Config {
   int pgsz;                       /* Approximate page size used in %_data */
   int nAutomerge;                 /* 'automerge' setting */
   int nCrisisMerge;               /* Maximum allowed segments per level */
+  int nQueryCache;                /* 'querycache' doclist cache budget, bytes */
+  int bBackgroundMerge;           /* 'backgroundmerge' setting: writers skip
+                                  ** crisis merges past the first level, on
+                                  ** the promise that another connection runs
+                                  ** the 'merge' command periodically */
   int nUsermerge;                 /* 'usermerge' setting */
   int nHashSize;                  /* Bytes of memory for in-memory hash */
   char *zRank;                    /* Name of rank function */
@@ -563,6 +568,23 @@ int sqlite3Fts5PutVarint(unsigned char *p, u64 v);
   }                                               \
 }
 
+/*
+** Equivalent of fts5FastGetVarint32() for 64-bit values.  The one- and
+** two-byte cases cover nearly every rowid delta in a mature index, so
+** they are decoded inline and only longer varints take the call.
+*/
+#define fts5FastGetVarint64(a, iOff, nVal) {          \
+  nVal = (a)[iOff++];                                 \
+  if( nVal & 0x80 ){                                  \
+    if( ((a)[iOff] & 0x80)==0 ){                      \
+      nVal = ((nVal & 0x7f)<<7) | (a)[iOff++];        \
+    }else{                                            \
+      iOff--;                                         \
+      iOff += sqlite3Fts5GetVarint(&(a)[iOff], (u64*)&(nVal)); \
+    }                                                 \
+  }                                                   \
+}
+
 
 /*
 ** End of interface to code in fts5_varint.c.
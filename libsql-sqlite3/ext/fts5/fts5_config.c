@@ -924,6 +924,26 @@ int sqlite3Fts5ConfigSetValue(
     }
   }
 
+  else if( 0==sqlite3_stricmp(zKey, "querycache") ){
+    int nVal = -1;
+    if( SQLITE_INTEGER==sqlite3_value_numeric_type(pVal) ){
+      nVal = sqlite3_value_int(pVal);
+    }
+    if( nVal<0 ){
+      *pbBadkey = 1;
+    }else{
+      pConfig->nQueryCache = nVal;
+    }
+  }
+
+  else if( 0==sqlite3_stricmp(zKey, "backgroundmerge") ){
+    if( SQLITE_INTEGER==sqlite3_value_numeric_type(pVal) ){
+      pConfig->bBackgroundMerge = sqlite3_value_int(pVal)!=0;
+    }else{
+      *pbBadkey = 1;
+    }
+  }
+
   else if( 0==sqlite3_stricmp(zKey, "deletemerge") ){
     int nVal = -1;
     if( SQLITE_INTEGER==sqlite3_value_numeric_type(pVal) ){
@@ -372,8 +372,131 @@ struct Fts5Index {
   sqlite3_stmt *pDataVersion;
   i64 iStructVersion;             /* data_version when pStruct read */
   Fts5Structure *pStruct;         /* Current db structure (or NULL) */
+
+  /* Term doclist cache (the 'querycache' option).  Entries are valid
+  ** while both version stamps match: iWriteEpoch covers writes through
+  ** this connection (PRAGMA data_version does not see those), and the
+  ** data_version covers commits by other connections.  Merges do not
+  ** invalidate entries because they do not change logical content. */
+  struct Fts5QCacheEntry {
+    u8 *aDoclist;                 /* Cached doclist, or NULL if slot empty */
+    int nDoclist;                 /* Size of aDoclist in bytes */
+    char *zTerm;                  /* Term (with index prefix byte) */
+    int nTerm;                    /* Size of zTerm in bytes */
+    i64 iDataVersion;             /* data_version the entry was built at */
+    i64 iWriteEpoch;              /* Fts5Index.iWriteEpoch at build time */
+    u32 iLastUsed;                /* For LRU replacement */
+  } aQCache[16];
+  int nQCacheMem;                 /* Total bytes of cached doclists */
+  u32 iQCacheTick;                /* Incremented on each cache access */
+  i64 iWriteEpoch;                /* Incremented on each local write */
 };
 
+static i64 fts5IndexDataVersion(Fts5Index*);
+
+/* Queries eligible for the term doclist cache carry no flags other
+** than these */
+#define FTS5_QCACHE_OKFLAGS (FTS5INDEX_QUERY_DESC|FTS5INDEX_QUERY_SKIPEMPTY)
+
+/* Discard all entries from the term doclist cache */
+static void fts5QueryCacheClear(Fts5Index *p){
+  int i;
+  for(i=0; i<(int)ArraySize(p->aQCache); i++){
+    sqlite3_free(p->aQCache[i].aDoclist);
+    sqlite3_free(p->aQCache[i].zTerm);
+    memset(&p->aQCache[i], 0, sizeof(p->aQCache[i]));
+  }
+  p->nQCacheMem = 0;
+}
+
+/*
+** Search the doclist cache for zTerm/nTerm.  Returns the entry, or NULL
+** if there is no current entry for the term.
+*/
+static struct Fts5QCacheEntry *fts5QueryCacheFind(
+  Fts5Index *p,
+  const u8 *zTerm, int nTerm
+){
+  int i;
+  for(i=0; i<(int)ArraySize(p->aQCache); i++){
+    struct Fts5QCacheEntry *pE = &p->aQCache[i];
+    if( pE->aDoclist
+     && pE->nTerm==nTerm && memcmp(pE->zTerm, zTerm, nTerm)==0
+    ){
+      if( pE->iWriteEpoch==p->iWriteEpoch
+       && pE->iDataVersion==fts5IndexDataVersion(p)
+      ){
+        pE->iLastUsed = ++p->iQCacheTick;
+        return pE;
+      }
+      /* Stale entry: drop it */
+      p->nQCacheMem -= pE->nDoclist;
+      sqlite3_free(pE->aDoclist);
+      sqlite3_free(pE->zTerm);
+      memset(pE, 0, sizeof(*pE));
+      return 0;
+    }
+  }
+  return 0;
+}
+
+/*
+** Add a doclist to the cache, evicting least-recently-used entries as
+** required to stay within the configured byte budget.
+*/
+static void fts5QueryCacheAdd(
+  Fts5Index *p,
+  const u8 *zTerm, int nTerm,
+  const u8 *aDoclist, int nDoclist
+){
+  struct Fts5QCacheEntry *pE = 0;
+  int i;
+  int nBudget = p->pConfig->nQueryCache;
+  if( nDoclist > nBudget/4 ) return;
+  while( p->nQCacheMem+nDoclist > nBudget ){
+    struct Fts5QCacheEntry *pMin = 0;
+    for(i=0; i<(int)ArraySize(p->aQCache); i++){
+      if( p->aQCache[i].aDoclist
+       && (pMin==0 || p->aQCache[i].iLastUsed<pMin->iLastUsed)
+      ){
+        pMin = &p->aQCache[i];
+      }
+    }
+    if( pMin==0 ) return;
+    p->nQCacheMem -= pMin->nDoclist;
+    sqlite3_free(pMin->aDoclist);
+    sqlite3_free(pMin->zTerm);
+    memset(pMin, 0, sizeof(*pMin));
+  }
+  for(i=0; i<(int)ArraySize(p->aQCache); i++){
+    if( p->aQCache[i].aDoclist==0 ){ pE = &p->aQCache[i]; break; }
+    if( pE==0 || p->aQCache[i].iLastUsed<pE->iLastUsed ) pE = &p->aQCache[i];
+  }
+  if( pE->aDoclist ){
+    p->nQCacheMem -= pE->nDoclist;
+    sqlite3_free(pE->aDoclist);
+    sqlite3_free(pE->zTerm);
+    memset(pE, 0, sizeof(*pE));
+  }
+  pE->aDoclist = sqlite3_malloc64((u64)nDoclist+FTS5_DATA_ZERO_PADDING);
+  pE->zTerm = sqlite3_malloc64(nTerm);
+  if( pE->aDoclist==0 || pE->zTerm==0 ){
+    sqlite3_free(pE->aDoclist);
+    sqlite3_free(pE->zTerm);
+    memset(pE, 0, sizeof(*pE));
+    return;
+  }
+  memcpy(pE->aDoclist, aDoclist, nDoclist);
+  memset(&pE->aDoclist[nDoclist], 0, FTS5_DATA_ZERO_PADDING);
+  memcpy(pE->zTerm, zTerm, nTerm);
+  pE->nDoclist = nDoclist;
+  pE->nTerm = nTerm;
+  pE->iDataVersion = fts5IndexDataVersion(p);
+  pE->iWriteEpoch = p->iWriteEpoch;
+  pE->iLastUsed = ++p->iQCacheTick;
+  p->nQCacheMem += nDoclist;
+}
+
 struct Fts5DoclistIter {
   u8 *aEof;                       /* Pointer to 1 byte past end of doclist */
 
@@ -2242,7 +2365,7 @@ static void fts5SegIterNext(
       }
     }else{
       u64 iDelta;
-      iOff += sqlite3Fts5GetVarint(&a[iOff], &iDelta);
+      fts5FastGetVarint64(a, iOff, iDelta);
       pIter->iRowid += iDelta;
       assert_nc( iDelta>0 );
     }
@@ -4855,6 +4978,13 @@ static void fts5IndexCrisismerge(
   if( pStruct && pStruct->nLevel>0 ){
     int iLvl = 0;
     while( p->rc==SQLITE_OK && pStruct->aLevel[iLvl].nSeg>=nCrisis ){
+      /* With 'backgroundmerge' set, the writing connection only relieves
+      ** level-0 crises (which grow with every flush and would otherwise
+      ** degrade lookups immediately) and leaves deeper, larger - and
+      ** therefore slower - merges to the connection that runs the
+      ** 'merge' command.  This trades bounded extra read fan-out for
+      ** steady ingest latency. */
+      if( p->pConfig->bBackgroundMerge && iLvl>0 ) break;
       fts5IndexMergeLevel(p, &pStruct, iLvl, 0);
       assert( p->rc!=SQLITE_OK || pStruct->nLevel>(iLvl+1) );
       fts5StructurePromote(p, iLvl+1, pStruct);
@@ -6234,6 +6364,7 @@ int sqlite3Fts5IndexSync(Fts5Index *p){
 ** records must be invalidated.
 */
 int sqlite3Fts5IndexRollback(Fts5Index *p){
+  p->iWriteEpoch++;
   sqlite3Fts5IndexCloseReader(p);
   fts5IndexDiscardData(p);
   fts5StructureInvalidate(p);
@@ -6248,6 +6379,8 @@ int sqlite3Fts5IndexRollback(Fts5Index *p){
 */
 int sqlite3Fts5IndexReinit(Fts5Index *p){
   Fts5Structure s;
+  p->iWriteEpoch++;
+  fts5QueryCacheClear(p);
   fts5StructureInvalidate(p);
   fts5IndexDiscardData(p);
   memset(&s, 0, sizeof(Fts5Structure));
@@ -6311,6 +6444,7 @@ int sqlite3Fts5IndexClose(Fts5Index *p){
   int rc = SQLITE_OK;
   if( p ){
     assert( p->pReader==0 );
+    fts5QueryCacheClear(p);
     fts5StructureInvalidate(p);
     sqlite3_finalize(p->pWriter);
     sqlite3_finalize(p->pDeleter);
@@ -6390,6 +6524,8 @@ int sqlite3Fts5IndexWrite(
   int rc = SQLITE_OK;             /* Return code */
   Fts5Config *pConfig = p->pConfig;
 
+  p->iWriteEpoch++;
+
   assert( p->rc==SQLITE_OK );
   assert( (iCol<0)==p->bDelete );
 
@@ -6462,13 +6598,110 @@ int sqlite3Fts5IndexQuery(
 
     if( iIdx<=pConfig->nPrefix ){
       /* Straight index lookup */
-      Fts5Structure *pStruct = fts5StructureRead(p);
+      int bCacheable = pConfig->nQueryCache>0 && pColset==0 && iIdx==0
+                    && (flags & ~FTS5_QCACHE_OKFLAGS)==0;
+      int bDesc = (flags & FTS5INDEX_QUERY_DESC)!=0;
+      struct Fts5QCacheEntry *pE = 0;
       buf.p[0] = (u8)(FTS5_MAIN_PREFIX + iIdx);
-      if( pStruct ){
-        fts5MultiIterNew(p, pStruct, flags | FTS5INDEX_QUERY_SKIPEMPTY, 
-            pColset, buf.p, nToken+1, -1, 0, &pRet
-        );
+      if( bCacheable ) pE = fts5QueryCacheFind(p, buf.p, nToken+1);
+      if( pE ){
+        /* Replay the cached doclist through the same in-memory doclist
+        ** iterator that prefix queries use */
+        Fts5Data *pData = fts5IdxMalloc(p, sizeof(Fts5Data)+pE->nDoclist
+                                           +FTS5_DATA_ZERO_PADDING);
+        if( pData ){
+          pData->p = (u8*)&pData[1];
+          pData->nn = pData->szLeaf = pE->nDoclist;
+          memcpy(pData->p, pE->aDoclist, pE->nDoclist+FTS5_DATA_ZERO_PADDING);
+          fts5MultiIterNew2(p, pData, bDesc, &pRet);
+        }
+        if( pRet ){
+          fts5IterSetOutputCb(&p->rc, pRet);
+          if( p->rc==SQLITE_OK ){
+            Fts5SegIter *pSeg = &pRet->aSeg[pRet->aFirst[1].iFirst];
+            if( pSeg->pLeaf ) pRet->xSetOutputs(pRet, pSeg);
+          }
+        }
+      }else if( bCacheable ){
+        /* Materialize the doclist once, cache it, and iterate the
+        ** materialized copy */
+        Fts5Structure *pStruct = fts5StructureRead(p);
+        if( pStruct ){
+          const int f2 = FTS5INDEX_QUERY_SKIPEMPTY|FTS5INDEX_QUERY_NOOUTPUT;
+          void (*xAppend)(Fts5Index*, u64, Fts5Iter*, Fts5Buffer*);
+          Fts5Iter *p1 = 0;
+          Fts5Buffer doclist;
+          Fts5Data *pData;
+          i64 iLastRowid = 0;
+          int dummy = 0;
+          int nAdmit = pConfig->nQueryCache/4;  /* fts5QueryCacheAdd() limit */
+          int bAbandon = 0;
+          if( pConfig->eDetail==FTS5_DETAIL_NONE ){
+            xAppend = fts5AppendRowid;
+          }else{
+            xAppend = fts5AppendPoslist;
+          }
+          memset(&doclist, 0, sizeof(doclist));
+          fts5MultiIterNew(p, pStruct, f2, 0, buf.p, nToken+1, -1, 0, &p1);
+          fts5IterSetOutputCb(&p->rc, p1);
+          for(;
+            fts5MultiIterEof(p, p1)==0;
+            fts5MultiIterNext2(p, p1, &dummy)
+          ){
+            Fts5SegIter *pSeg = &p1->aSeg[ p1->aFirst[1].iFirst ];
+            p1->xSetOutputs(p1, pSeg);
+            if( p1->base.nData ){
+              xAppend(p, (u64)p1->base.iRowid-(u64)iLastRowid, p1, &doclist);
+              iLastRowid = p1->base.iRowid;
+              if( doclist.n>nAdmit ){
+                /* The doclist has already outgrown what the cache would
+                ** admit: stop materializing now instead of copying a
+                ** multi-megabyte hot term on every query. */
+                bAbandon = 1;
+                break;
+              }
+            }
+          }
+          fts5MultiIterFree(p1);
+          if( bAbandon ){
+            /* Fall back to the streaming, early-terminating iterator,
+            ** exactly as if the cache were not configured. */
+            fts5BufferFree(&doclist);
+            fts5MultiIterNew(p, pStruct, flags | FTS5INDEX_QUERY_SKIPEMPTY,
+                pColset, buf.p, nToken+1, -1, 0, &pRet
+            );
+          }else{
+            if( p->rc==SQLITE_OK ){
+              fts5QueryCacheAdd(p, buf.p, nToken+1, doclist.p, doclist.n);
+            }
+            pData = fts5IdxMalloc(p, sizeof(Fts5Data)+doclist.n
+                                     +FTS5_DATA_ZERO_PADDING);
+            if( pData ){
+              pData->p = (u8*)&pData[1];
+              pData->nn = pData->szLeaf = doclist.n;
+              if( doclist.n ) memcpy(pData->p, doclist.p, doclist.n);
+              memset(&pData->p[doclist.n], 0, FTS5_DATA_ZERO_PADDING);
+              fts5MultiIterNew2(p, pData, bDesc, &pRet);
+            }
+            fts5BufferFree(&doclist);
+          }
+          if( pRet ){
+            fts5IterSetOutputCb(&p->rc, pRet);
+            if( p->rc==SQLITE_OK ){
+              Fts5SegIter *pSeg = &pRet->aSeg[pRet->aFirst[1].iFirst];
+              if( pSeg->pLeaf ) pRet->xSetOutputs(pRet, pSeg);
+            }
+          }
+        }
         fts5StructureRelease(pStruct);
+      }else{
+        Fts5Structure *pStruct = fts5StructureRead(p);
+        if( pStruct ){
+          fts5MultiIterNew(p, pStruct, flags | FTS5INDEX_QUERY_SKIPEMPTY, 
+              pColset, buf.p, nToken+1, -1, 0, &pRet
+          );
+          fts5StructureRelease(pStruct);
+        }
       }
     }else{
       /* Scan multiple terms in the main index */
@@ -6599,6 +6832,7 @@ int sqlite3Fts5IndexGetAverages(Fts5Index *p, i64 *pnRow, i64 *anSize){
 */
 int sqlite3Fts5IndexSetAverages(Fts5Index *p, const u8 *pData, int nData){
   assert( p->rc==SQLITE_OK );
+  p->iWriteEpoch++;
   fts5DataWrite(p, FTS5_AVERAGES_ROWID, pData, nData);
   return fts5IndexReturn(p);
 }
@@ -6625,6 +6859,7 @@ int sqlite3Fts5IndexSetCookie(Fts5Index *p, int iNew){
   sqlite3_blob *pBlob = 0;
 
   assert( p->rc==SQLITE_OK );
+  p->iWriteEpoch++;
   sqlite3Fts5Put32(aCookie, iNew);
 
   rc = sqlite3_blob_open(pConfig->db, pConfig->zDb, p->zDataTbl, 
@@ -6965,6 +7200,11 @@ static void fts5IndexTombstoneAdd(
 */
 int sqlite3Fts5IndexContentlessDelete(Fts5Index *p, i64 iOrigin, i64 iRowid){
   Fts5Structure *pStruct;
+  /* Tombstones remove rowids from query results without passing through
+  ** sqlite3Fts5IndexWrite(), and same-connection writes do not change
+  ** data_version, so bump the epoch here or cached doclists would
+  ** replay the deleted rowid. */
+  p->iWriteEpoch++;
   pStruct = fts5StructureRead(p);
   if( pStruct ){
     int bFound = 0;               /* True after pSeg->nEntryTombstone incr. */
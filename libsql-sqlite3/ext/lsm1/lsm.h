@@ -277,6 +277,18 @@ int lsm_config(lsm_db *, int, ...);
 **   Configure a factory method to be invoked in case of an LSM_MISMATCH
 **   error.
 **
+** LSM_CONFIG_BACKGROUND_WORKER:
+**   A read/write integer parameter.  Setting it to a non-zero value
+**   starts a library-managed background thread that opens its own
+**   connection to the same database and drives lsm_work() whenever
+**   there is work to do, so the application's write path no longer
+**   stalls performing merges when levels pile up.  Setting it to zero
+**   stops (and joins) the thread; it is also stopped automatically by
+**   lsm_close().  Most deployments using it will also set
+**   LSM_CONFIG_AUTOWORK to zero on the writing connection.  On
+**   platforms without pthreads the value reads back as zero and no
+**   thread is started.
+**
 ** LSM_CONFIG_READONLY:
 **   A read/write boolean parameter. This parameter may only be set before
 **   lsm_open() is called.
@@ -296,6 +308,7 @@ int lsm_config(lsm_db *, int, ...);
 #define LSM_CONFIG_GET_COMPRESSION         14
 #define LSM_CONFIG_SET_COMPRESSION_FACTORY 15
 #define LSM_CONFIG_READONLY                16
+#define LSM_CONFIG_BACKGROUND_WORKER       17
 
 #define LSM_SAFETY_OFF    0
 #define LSM_SAFETY_NORMAL 1
@@ -354,6 +354,7 @@ struct lsm_db {
   i64 nAutockpt;                  /* Configured by LSM_CONFIG_AUTOCHECKPOINT */
   int bMultiProc;                 /* Configured by L_C_MULTIPLE_PROCESSES */
   int bReadonly;                  /* Configured by LSM_CONFIG_READONLY */
+  struct LsmBgWorker *pBgWorker;  /* Background worker thread, if any */
   lsm_compress compress;          /* Compression callbacks */
   lsm_compress_factory factory;   /* Compression callback factory */
 
@@ -890,6 +891,7 @@ int lsmInfoLogStructure(lsm_db *pDb, char **pzVal);
 */
 
 int lsmDbDatabaseConnect(lsm_db*, const char *);
+const char *lsmDbName(lsm_db *pDb);
 void lsmDbDatabaseRelease(lsm_db *);
 
 int lsmBeginReadTrans(lsm_db *);
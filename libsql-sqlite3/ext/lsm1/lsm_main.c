@@ -210,6 +210,137 @@ int lsm_open(lsm_db *pDb, const char *zFilename){
   return rc;
 }
 
+
+#ifdef LSM_MUTEX_PTHREADS
+#include <pthread.h>
+#include <string.h>
+
+/*
+** State for the library-managed background worker thread (see
+** LSM_CONFIG_BACKGROUND_WORKER in lsm.h).  The worker runs on its own
+** connection so it takes the WORKER lock like any other process would;
+** the owning handle only ever starts, signals and joins it.
+*/
+typedef struct LsmBgWorker LsmBgWorker;
+struct LsmBgWorker {
+  pthread_t tid;                  /* The worker thread */
+  pthread_mutex_t mtx;            /* Protects the fields below */
+  pthread_cond_t cond;            /* Signalled to wake or stop the worker */
+  int bStop;                      /* Tell the worker to exit */
+  int bWork;                      /* Owner committed since the last pass */
+  int bExited;                    /* Worker thread has returned */
+  int rcWorker;                   /* First error hit by the worker */
+  lsm_compress compress;          /* Owner's compression hooks, copied */
+  lsm_compress_factory factory;   /* Owner's compression factory, copied */
+  char *zDb;                      /* Database path to open */
+};
+
+static void *lsmBgWorkerMain(void *pArg){
+  LsmBgWorker *p = (LsmBgWorker*)pArg;
+  lsm_db *db = 0;
+  int rc;
+
+  /* The worker's private connection must see the same compression
+  ** configuration as its owner, or lsm_open() on a compressed database
+  ** fails (or worse, a factory-provided scheme is never installed) and
+  ** the worker dies without doing anything. */
+  rc = lsm_new(0, &db);
+  if( rc==LSM_OK && p->compress.xCompress ){
+    rc = lsm_config(db, LSM_CONFIG_SET_COMPRESSION, &p->compress);
+  }
+  if( rc==LSM_OK && p->factory.xFactory ){
+    rc = lsm_config(db, LSM_CONFIG_SET_COMPRESSION_FACTORY, &p->factory);
+  }
+  if( rc==LSM_OK ) rc = lsm_open(db, p->zDb);
+  if( rc==LSM_OK ){
+    int bStop = 0;
+    while( !bStop ){
+      int nWrite = 0;
+      rc = lsm_work(db, 0, 512, &nWrite);
+      if( rc==LSM_OK ) lsm_checkpoint(db, 0);
+      if( rc!=LSM_OK && rc!=LSM_BUSY ) break;
+      rc = LSM_OK;
+      pthread_mutex_lock(&p->mtx);
+      if( !p->bStop && !p->bWork && nWrite==0 ){
+        /* Nothing to merge and no commit signalled: sleep until woken.
+        ** The 100ms timeout only covers writes by other processes,
+        ** which cannot signal this condition variable. */
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += 100*1000*1000;
+        if( ts.tv_nsec>=1000000000 ){ ts.tv_sec++; ts.tv_nsec -= 1000000000; }
+        pthread_cond_timedwait(&p->cond, &p->mtx, &ts);
+      }
+      p->bWork = 0;
+      bStop = p->bStop;
+      pthread_mutex_unlock(&p->mtx);
+    }
+  }
+  pthread_mutex_lock(&p->mtx);
+  p->rcWorker = rc;
+  p->bExited = 1;
+  pthread_mutex_unlock(&p->mtx);
+  if( db ) lsm_close(db);
+  return 0;
+}
+
+/*
+** Called by the owning connection after it commits a write: wake the
+** worker immediately instead of letting it wait out the poll interval.
+*/
+static void lsmBgWorkerSignal(lsm_db *pDb){
+  LsmBgWorker *p = (LsmBgWorker*)pDb->pBgWorker;
+  if( p ){
+    pthread_mutex_lock(&p->mtx);
+    p->bWork = 1;
+    pthread_cond_signal(&p->cond);
+    pthread_mutex_unlock(&p->mtx);
+  }
+}
+
+static int lsmBgWorkerStart(lsm_db *pDb){
+  LsmBgWorker *p;
+  const char *zName = lsmDbName(pDb);
+  int nName;
+  if( zName==0 ) return LSM_MISUSE_BKPT;
+  nName = lsmStrlen(zName);
+  p = (LsmBgWorker*)lsmMallocZero(pDb->pEnv, sizeof(*p)+nName+1);
+  if( p==0 ) return LSM_NOMEM_BKPT;
+  p->zDb = (char*)&p[1];
+  memcpy(p->zDb, zName, nName+1);
+  p->compress = pDb->compress;
+  p->factory = pDb->factory;
+  pthread_mutex_init(&p->mtx, 0);
+  pthread_cond_init(&p->cond, 0);
+  if( pthread_create(&p->tid, 0, lsmBgWorkerMain, (void*)p) ){
+    pthread_cond_destroy(&p->cond);
+    pthread_mutex_destroy(&p->mtx);
+    lsmFree(pDb->pEnv, p);
+    return LSM_ERROR;
+  }
+  pDb->pBgWorker = p;
+  return LSM_OK;
+}
+
+static void lsmBgWorkerStop(lsm_db *pDb){
+  LsmBgWorker *p = (LsmBgWorker*)pDb->pBgWorker;
+  if( p ){
+    pthread_mutex_lock(&p->mtx);
+    p->bStop = 1;
+    pthread_cond_signal(&p->cond);
+    pthread_mutex_unlock(&p->mtx);
+    pthread_join(p->tid, 0);
+    pthread_cond_destroy(&p->cond);
+    pthread_mutex_destroy(&p->mtx);
+    lsmFree(pDb->pEnv, p);
+    pDb->pBgWorker = 0;
+  }
+}
+#else
+# define lsmBgWorkerStop(pDb)
+# define lsmBgWorkerSignal(pDb)
+#endif /* LSM_MUTEX_PTHREADS */
+
 int lsm_close(lsm_db *pDb){
   int rc = LSM_OK;
   if( pDb ){
@@ -217,6 +348,7 @@ int lsm_close(lsm_db *pDb){
     if( pDb->pCsr || pDb->nTransOpen ){
       rc = LSM_MISUSE_BKPT;
     }else{
+      lsmBgWorkerStop(pDb);
       lsmMCursorFreeCache(pDb);
       lsmFreeSnapshot(pDb->pEnv, pDb->pClient);
       pDb->pClient = 0;
@@ -269,6 +401,31 @@ int lsm_config(lsm_db *pDb, int eParam, ...){
       break;
     }
 
+    case LSM_CONFIG_BACKGROUND_WORKER: {
+      int *piVal = va_arg(ap, int *);
+#ifdef LSM_MUTEX_PTHREADS
+      if( *piVal>0 && pDb->pBgWorker==0 ){
+        rc = lsmBgWorkerStart(pDb);
+      }else if( *piVal==0 ){
+        lsmBgWorkerStop(pDb);
+      }
+      if( pDb->pBgWorker ){
+        /* Report whether the thread is still running and surface the
+        ** first error it hit (e.g. failing to open the database). */
+        LsmBgWorker *p = (LsmBgWorker*)pDb->pBgWorker;
+        pthread_mutex_lock(&p->mtx);
+        *piVal = p->bExited==0;
+        if( rc==LSM_OK && p->rcWorker!=LSM_OK ) rc = p->rcWorker;
+        pthread_mutex_unlock(&p->mtx);
+      }else{
+        *piVal = 0;
+      }
+#else
+      if( *piVal>=0 ) *piVal = 0;
+#endif
+      break;
+    }
+
     case LSM_CONFIG_AUTOCHECKPOINT: {
       /* This parameter is read and written in KB. But all internal processing
       ** (including the lsm_db.nAutockpt variable) is done in bytes.  */
@@ -931,6 +1088,9 @@ int lsm_commit(lsm_db *pDb, int iLevel){
     }
     pDb->nTransOpen = iLevel;
   }
+  if( rc==LSM_OK && iLevel==0 && pDb->pBgWorker ){
+    lsmBgWorkerSignal(pDb);
+  }
   dbReleaseClientSnapshot(pDb);
   return rc;
 }
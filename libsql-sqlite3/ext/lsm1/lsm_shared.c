@@ -59,6 +59,11 @@ struct Database {
   lsm_db *pConn;                  /* List of connections to this db. */
 };
 
+/* Return the canonical path of the database file that pDb is open on */
+const char *lsmDbName(lsm_db *pDb){
+  return pDb->pDatabase ? pDb->pDatabase->zName : 0;
+}
+
 /*
 ** Functions to enter and leave the global mutex. This mutex is used
 ** to protect the global linked-list headed at gShared.pDatabase.
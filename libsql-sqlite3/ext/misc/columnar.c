@@ -0,0 +1,612 @@
+/*
+** 2026-09-01
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+**
+** This file implements a read-only columnar shadow of an ordinary
+** rowstore table, for analytic scans that touch few columns of wide
+** tables:
+**
+**    CREATE VIRTUAL TABLE cs USING columnar(tbl);
+**
+** The source table is materialized at CREATE time into a shadow table
+** "<name>_chunks" holding one BLOB per (chunk, column) pair, where a
+** chunk covers up to 4096 consecutive source rows.  A scan of the
+** virtual table decodes a column's blob only when the query actually
+** reads that column, so SUM(one_column) over a 80-column table fetches
+** roughly 1/80th of the data an OP_Column scan of the rowstore drags
+** through the page cache - and what it fetches is contiguous.
+**
+** Within a chunk a column is encoded as:
+**
+**     1 type byte per row:  0=NULL 1=INTEGER 2=REAL 3=TEXT 4=BLOB
+**     8 bytes per row:      the value for INTEGER/REAL; for TEXT and
+**                           BLOB, a (u32 offset, u32 length) pair into
+**                           the variable section
+**     variable section:     TEXT and BLOB payloads, concatenated
+**
+** The shadow is a snapshot: it reflects the source table as of the
+** CREATE (or the most recent rebuild via DROP/CREATE).  Writes go to
+** the source table as usual; the module itself is read-only.
+**
+** This is deliberately the "read-only columnar shadow" form of the
+** feature: a first-class writable columnar engine would need its own
+** transaction and balance machinery inside the b-tree layer.
+*/
+#include "sqlite3ext.h"
+SQLITE_EXTENSION_INIT1
+#include <string.h>
+#include <assert.h>
+#include <stdlib.h>
+
+#ifndef SQLITE_OMIT_VIRTUALTABLE
+
+#define COLUMNAR_CHUNK 4096     /* Source rows per chunk */
+
+typedef struct ColumnarTab ColumnarTab;
+typedef struct ColumnarCsr ColumnarCsr;
+typedef struct ColumnarBlob ColumnarBlob;
+
+/* A decoded (or raw) per-chunk column blob */
+struct ColumnarBlob {
+  unsigned char *a;             /* Blob content, or NULL if not loaded */
+  int n;                        /* Size in bytes */
+};
+
+struct ColumnarTab {
+  sqlite3_vtab base;            /* Base class - must be first */
+  sqlite3 *db;                  /* Database connection */
+  char *zDb;                    /* Database holding the shadow table */
+  char *zName;                  /* Name of this virtual table */
+  char *zSrc;                   /* Name of the source table */
+  int nCol;                     /* Number of columns */
+};
+
+struct ColumnarCsr {
+  sqlite3_vtab_cursor base;     /* Base class - must be first */
+  sqlite3_stmt *pChunk;         /* Iterates chunk numbers */
+  sqlite3_stmt *pLoad;          /* Loads one (chunk, column) blob */
+  sqlite3_int64 iChunk;         /* Current chunk number */
+  int nRow;                     /* Rows in the current chunk */
+  int iRow;                     /* Current row within the chunk */
+  int bEof;                     /* True at end of scan */
+  ColumnarBlob *aCol;           /* nCol+1 entries; [nCol] holds rowids */
+};
+
+/* Free all loaded column blobs of the current chunk */
+static void columnarClearChunk(ColumnarCsr *pCsr, int nCol){
+  int i;
+  if( pCsr->aCol ){
+    for(i=0; i<=nCol; i++){
+      sqlite3_free(pCsr->aCol[i].a);
+      pCsr->aCol[i].a = 0;
+      pCsr->aCol[i].n = 0;
+    }
+  }
+}
+
+/*
+** Load the blob for column iCol (or the rowid column when iCol==nCol)
+** of the current chunk into pCsr->aCol[iCol].
+*/
+static int columnarLoadCol(ColumnarCsr *pCsr, int iCol){
+  ColumnarBlob *p = &pCsr->aCol[iCol];
+  int rc;
+  if( p->a ) return SQLITE_OK;
+  sqlite3_bind_int64(pCsr->pLoad, 1, pCsr->iChunk);
+  sqlite3_bind_int(pCsr->pLoad, 2, iCol);
+  rc = sqlite3_step(pCsr->pLoad);
+  if( rc==SQLITE_ROW ){
+    int n = sqlite3_column_bytes(pCsr->pLoad, 0);
+    const void *a = sqlite3_column_blob(pCsr->pLoad, 0);
+    p->a = sqlite3_malloc64(n>0 ? n : 1);
+    if( p->a==0 ){
+      sqlite3_reset(pCsr->pLoad);
+      return SQLITE_NOMEM;
+    }
+    memcpy(p->a, a, n);
+    p->n = n;
+    rc = SQLITE_OK;
+  }else{
+    rc = SQLITE_CORRUPT_VTAB;
+  }
+  sqlite3_reset(pCsr->pLoad);
+  return rc;
+}
+
+/*
+** Rebuild the shadow table from the source table.  Called by xCreate.
+*/
+static int columnarBuild(ColumnarTab *pTab, char **pzErr){
+  sqlite3 *db = pTab->db;
+  sqlite3_stmt *pSel = 0;
+  sqlite3_stmt *pIns = 0;
+  unsigned char **aEnc = 0;     /* Fixed sections, one per column + rowid */
+  unsigned char **aVar = 0;     /* Variable sections */
+  int *anVar = 0;               /* Bytes used in each variable section */
+  int *anVarAlloc = 0;          /* Bytes allocated for each var section */
+  int nCol = pTab->nCol;
+  int nRow = 0;
+  sqlite3_int64 iChunk = 0;
+  int rc;
+  int i;
+  char *zSql;
+
+  zSql = sqlite3_mprintf("SELECT rowid, * FROM \"%w\"", pTab->zSrc);
+  if( zSql==0 ) return SQLITE_NOMEM;
+  rc = sqlite3_prepare_v2(db, zSql, -1, &pSel, 0);
+  sqlite3_free(zSql);
+  if( rc!=SQLITE_OK ){
+    *pzErr = sqlite3_mprintf("columnar: cannot read \"%s\": %s",
+                             pTab->zSrc, sqlite3_errmsg(db));
+    return rc;
+  }
+  if( sqlite3_column_count(pSel)!=nCol+1 ){
+    sqlite3_finalize(pSel);
+    *pzErr = sqlite3_mprintf("columnar: column count mismatch");
+    return SQLITE_ERROR;
+  }
+  zSql = sqlite3_mprintf(
+      "INSERT INTO \"%w\".\"%w_chunks\"(cno,cix,data) VALUES(?,?,?)",
+      pTab->zDb, pTab->zName);
+  if( zSql ){
+    rc = sqlite3_prepare_v2(db, zSql, -1, &pIns, 0);
+    sqlite3_free(zSql);
+  }else{
+    rc = SQLITE_NOMEM;
+  }
+  aEnc = sqlite3_malloc64(sizeof(*aEnc)*(nCol+1));
+  aVar = sqlite3_malloc64(sizeof(*aVar)*(nCol+1));
+  anVar = sqlite3_malloc64(sizeof(int)*2*(nCol+1));
+  if( aEnc==0 || aVar==0 || anVar==0 ) rc = SQLITE_NOMEM;
+  if( rc==SQLITE_OK ){
+    anVarAlloc = &anVar[nCol+1];
+    memset(aVar, 0, sizeof(*aVar)*(nCol+1));
+    memset(anVar, 0, sizeof(int)*2*(nCol+1));
+    for(i=0; i<=nCol; i++){
+      aEnc[i] = sqlite3_malloc64((sqlite3_int64)9*COLUMNAR_CHUNK);
+      if( aEnc[i]==0 ) rc = SQLITE_NOMEM;
+    }
+  }
+
+  while( rc==SQLITE_OK && SQLITE_ROW==sqlite3_step(pSel) ){
+    for(i=0; i<=nCol; i++){
+      unsigned char *pType = &aEnc[i][nRow];
+      unsigned char *pFix = &aEnc[i][COLUMNAR_CHUNK + 8*nRow];
+      int eType = i==0 ? SQLITE_INTEGER : sqlite3_column_type(pSel, i);
+      switch( eType ){
+        case SQLITE_INTEGER: {
+          sqlite3_int64 v = sqlite3_column_int64(pSel, i);
+          *pType = 1;
+          memcpy(pFix, &v, 8);
+          break;
+        }
+        case SQLITE_FLOAT: {
+          double r = sqlite3_column_double(pSel, i);
+          *pType = 2;
+          memcpy(pFix, &r, 8);
+          break;
+        }
+        case SQLITE_TEXT:
+        case SQLITE_BLOB: {
+          int n = sqlite3_column_bytes(pSel, i);
+          const void *a = eType==SQLITE_TEXT
+              ? (const void*)sqlite3_column_text(pSel, i)
+              : sqlite3_column_blob(pSel, i);
+          unsigned int aOffLen[2];
+          int ix = i==0 ? nCol : i-1;  /* var section index; unused for 0 */
+          *pType = eType==SQLITE_TEXT ? 3 : 4;
+          if( anVar[ix]+n>anVarAlloc[ix] ){
+            int nNew = (anVar[ix]+n)*2 + 1024;
+            unsigned char *p2 = sqlite3_realloc64(aVar[ix], nNew);
+            if( p2==0 ){ rc = SQLITE_NOMEM; break; }
+            aVar[ix] = p2;
+            anVarAlloc[ix] = nNew;
+          }
+          if( n>0 ) memcpy(&aVar[ix][anVar[ix]], a, n);
+          aOffLen[0] = (unsigned int)anVar[ix];
+          aOffLen[1] = (unsigned int)n;
+          anVar[ix] += n;
+          memcpy(pFix, aOffLen, 8);
+          break;
+        }
+        default: {
+          *pType = 0;
+          memset(pFix, 0, 8);
+          break;
+        }
+      }
+      if( rc ) break;
+    }
+    if( rc ) break;
+    nRow++;
+    if( nRow==COLUMNAR_CHUNK ){
+      /* Flush the chunk */
+      for(i=0; rc==SQLITE_OK && i<=nCol; i++){
+        int ix = i==0 ? nCol : i-1;
+        sqlite3_int64 nBlob = (sqlite3_int64)9*nRow + (i ? anVar[ix] : 0);
+        unsigned char *aBlob = sqlite3_malloc64(nBlob>0 ? nBlob : 1);
+        if( aBlob==0 ){ rc = SQLITE_NOMEM; break; }
+        memcpy(aBlob, aEnc[i], nRow);
+        memcpy(&aBlob[nRow], &aEnc[i][COLUMNAR_CHUNK], 8*nRow);
+        if( i && anVar[ix] ) memcpy(&aBlob[9*nRow], aVar[ix], anVar[ix]);
+        sqlite3_bind_int64(pIns, 1, iChunk);
+        sqlite3_bind_int(pIns, 2, i==0 ? nCol : i-1);
+        sqlite3_bind_blob64(pIns, 3, aBlob, nBlob, sqlite3_free);
+        if( SQLITE_DONE!=sqlite3_step(pIns) ) rc = sqlite3_errcode(db);
+        sqlite3_reset(pIns);
+        if( i ) anVar[ix] = 0;
+      }
+      iChunk++;
+      nRow = 0;
+    }
+  }
+  if( rc==SQLITE_OK && nRow>0 ){
+    for(i=0; rc==SQLITE_OK && i<=nCol; i++){
+      int ix = i==0 ? nCol : i-1;
+      sqlite3_int64 nBlob = (sqlite3_int64)9*nRow + (i ? anVar[ix] : 0);
+      unsigned char *aBlob = sqlite3_malloc64(nBlob>0 ? nBlob : 1);
+      if( aBlob==0 ){ rc = SQLITE_NOMEM; break; }
+      memcpy(aBlob, aEnc[i], nRow);
+      memcpy(&aBlob[nRow], &aEnc[i][COLUMNAR_CHUNK], 8*nRow);
+      if( i && anVar[ix] ) memcpy(&aBlob[9*nRow], aVar[ix], anVar[ix]);
+      sqlite3_bind_int64(pIns, 1, iChunk);
+      sqlite3_bind_int(pIns, 2, i==0 ? nCol : i-1);
+      sqlite3_bind_blob64(pIns, 3, aBlob, nBlob, sqlite3_free);
+      if( SQLITE_DONE!=sqlite3_step(pIns) ) rc = sqlite3_errcode(db);
+      sqlite3_reset(pIns);
+    }
+  }
+
+  if( aEnc ){ for(i=0; i<=nCol; i++) sqlite3_free(aEnc[i]); }
+  if( aVar ){ for(i=0; i<=nCol; i++) sqlite3_free(aVar[i]); }
+  sqlite3_free(aEnc);
+  sqlite3_free(aVar);
+  sqlite3_free(anVar);
+  sqlite3_finalize(pSel);
+  sqlite3_finalize(pIns);
+  return rc;
+}
+
+static int columnarConnectCreate(
+  sqlite3 *db,
+  void *pAux,
+  int argc, const char *const*argv,
+  sqlite3_vtab **ppVtab,
+  char **pzErr,
+  int bCreate
+){
+  ColumnarTab *pTab = 0;
+  sqlite3_str *pDecl;
+  sqlite3_stmt *pInfo = 0;
+  char *zSql;
+  int rc = SQLITE_OK;
+  int nCol = 0;
+
+  (void)pAux;
+  if( argc!=4 ){
+    *pzErr = sqlite3_mprintf("columnar: exactly one argument required");
+    return SQLITE_ERROR;
+  }
+  pTab = sqlite3_malloc64(sizeof(*pTab));
+  if( pTab==0 ) return SQLITE_NOMEM;
+  memset(pTab, 0, sizeof(*pTab));
+  pTab->db = db;
+  pTab->zDb = sqlite3_mprintf("%s", argv[1]);
+  pTab->zName = sqlite3_mprintf("%s", argv[2]);
+  pTab->zSrc = sqlite3_mprintf("%s", argv[3]);
+  if( pTab->zDb==0 || pTab->zName==0 || pTab->zSrc==0 ){
+    rc = SQLITE_NOMEM;
+    goto connect_error;
+  }
+
+  /* Declare the virtual table with the source table's column names */
+  pDecl = sqlite3_str_new(db);
+  sqlite3_str_appendf(pDecl, "CREATE TABLE x(");
+  zSql = sqlite3_mprintf("PRAGMA \"%w\".table_info(\"%w\")",
+                         pTab->zDb, pTab->zSrc);
+  if( zSql==0 || SQLITE_OK!=sqlite3_prepare_v2(db, zSql, -1, &pInfo, 0) ){
+    sqlite3_free(zSql);
+    sqlite3_free(sqlite3_str_finish(pDecl));
+    *pzErr = sqlite3_mprintf("columnar: no such table: %s", pTab->zSrc);
+    rc = SQLITE_ERROR;
+    goto connect_error;
+  }
+  sqlite3_free(zSql);
+  while( SQLITE_ROW==sqlite3_step(pInfo) ){
+    sqlite3_str_appendf(pDecl, "%s\"%w\"", nCol ? "," : "",
+                        sqlite3_column_text(pInfo, 1));
+    nCol++;
+  }
+  sqlite3_finalize(pInfo);
+  sqlite3_str_appendf(pDecl, ")");
+  zSql = sqlite3_str_finish(pDecl);
+  if( nCol==0 ){
+    sqlite3_free(zSql);
+    *pzErr = sqlite3_mprintf("columnar: no such table: %s", pTab->zSrc);
+    rc = SQLITE_ERROR;
+    goto connect_error;
+  }
+  pTab->nCol = nCol;
+  rc = sqlite3_declare_vtab(db, zSql);
+  sqlite3_free(zSql);
+  if( rc ) goto connect_error;
+
+  if( bCreate ){
+    zSql = sqlite3_mprintf(
+        "CREATE TABLE \"%w\".\"%w_chunks\""
+        "(cno INTEGER, cix INTEGER, data BLOB, PRIMARY KEY(cno,cix))"
+        " WITHOUT ROWID", pTab->zDb, pTab->zName);
+    if( zSql==0 ){
+      rc = SQLITE_NOMEM;
+    }else{
+      rc = sqlite3_exec(db, zSql, 0, 0, 0);
+      sqlite3_free(zSql);
+    }
+    if( rc==SQLITE_OK ) rc = columnarBuild(pTab, pzErr);
+    if( rc ) goto connect_error;
+  }
+
+  *ppVtab = &pTab->base;
+  return SQLITE_OK;
+
+connect_error:
+  if( pTab ){
+    sqlite3_free(pTab->zDb);
+    sqlite3_free(pTab->zName);
+    sqlite3_free(pTab->zSrc);
+    sqlite3_free(pTab);
+  }
+  return rc;
+}
+
+static int columnarCreate(sqlite3 *db, void *pAux, int argc,
+    const char *const*argv, sqlite3_vtab **ppVtab, char **pzErr){
+  return columnarConnectCreate(db, pAux, argc, argv, ppVtab, pzErr, 1);
+}
+static int columnarConnect(sqlite3 *db, void *pAux, int argc,
+    const char *const*argv, sqlite3_vtab **ppVtab, char **pzErr){
+  return columnarConnectCreate(db, pAux, argc, argv, ppVtab, pzErr, 0);
+}
+
+static int columnarDisconnect(sqlite3_vtab *pVtab){
+  ColumnarTab *pTab = (ColumnarTab*)pVtab;
+  sqlite3_free(pTab->zDb);
+  sqlite3_free(pTab->zName);
+  sqlite3_free(pTab->zSrc);
+  sqlite3_free(pTab);
+  return SQLITE_OK;
+}
+
+static int columnarDestroy(sqlite3_vtab *pVtab){
+  ColumnarTab *pTab = (ColumnarTab*)pVtab;
+  char *zSql = sqlite3_mprintf("DROP TABLE IF EXISTS \"%w\".\"%w_chunks\"",
+                               pTab->zDb, pTab->zName);
+  int rc = zSql ? sqlite3_exec(pTab->db, zSql, 0, 0, 0) : SQLITE_NOMEM;
+  sqlite3_free(zSql);
+  if( rc==SQLITE_OK ) rc = columnarDisconnect(pVtab);
+  return rc;
+}
+
+static int columnarOpen(sqlite3_vtab *pVtab, sqlite3_vtab_cursor **ppCsr){
+  ColumnarTab *pTab = (ColumnarTab*)pVtab;
+  ColumnarCsr *pCsr;
+  char *zSql;
+  int rc = SQLITE_OK;
+
+  pCsr = sqlite3_malloc64(sizeof(*pCsr));
+  if( pCsr==0 ) return SQLITE_NOMEM;
+  memset(pCsr, 0, sizeof(*pCsr));
+  pCsr->aCol = sqlite3_malloc64(sizeof(ColumnarBlob)*(pTab->nCol+1));
+  if( pCsr->aCol==0 ){
+    sqlite3_free(pCsr);
+    return SQLITE_NOMEM;
+  }
+  memset(pCsr->aCol, 0, sizeof(ColumnarBlob)*(pTab->nCol+1));
+  zSql = sqlite3_mprintf(
+      "SELECT cno, length(data)/9 FROM \"%w\".\"%w_chunks\""
+      " WHERE cix=%d ORDER BY cno",
+      pTab->zDb, pTab->zName, pTab->nCol);
+  if( zSql==0 ) rc = SQLITE_NOMEM;
+  if( rc==SQLITE_OK ){
+    rc = sqlite3_prepare_v2(pTab->db, zSql, -1, &pCsr->pChunk, 0);
+  }
+  sqlite3_free(zSql);
+  if( rc==SQLITE_OK ){
+    zSql = sqlite3_mprintf(
+        "SELECT data FROM \"%w\".\"%w_chunks\" WHERE cno=?1 AND cix=?2",
+        pTab->zDb, pTab->zName);
+    if( zSql==0 ){
+      rc = SQLITE_NOMEM;
+    }else{
+      rc = sqlite3_prepare_v2(pTab->db, zSql, -1, &pCsr->pLoad, 0);
+      sqlite3_free(zSql);
+    }
+  }
+  if( rc ){
+    sqlite3_finalize(pCsr->pChunk);
+    sqlite3_free(pCsr->aCol);
+    sqlite3_free(pCsr);
+    return rc;
+  }
+  *ppCsr = &pCsr->base;
+  return SQLITE_OK;
+}
+
+static int columnarClose(sqlite3_vtab_cursor *cur){
+  ColumnarCsr *pCsr = (ColumnarCsr*)cur;
+  ColumnarTab *pTab = (ColumnarTab*)cur->pVtab;
+  columnarClearChunk(pCsr, pTab->nCol);
+  sqlite3_finalize(pCsr->pChunk);
+  sqlite3_finalize(pCsr->pLoad);
+  sqlite3_free(pCsr->aCol);
+  sqlite3_free(pCsr);
+  return SQLITE_OK;
+}
+
+/* Advance to the next chunk.  Returns SQLITE_OK and sets bEof at end */
+static int columnarNextChunk(ColumnarCsr *pCsr, int nCol){
+  int rc = sqlite3_step(pCsr->pChunk);
+  columnarClearChunk(pCsr, nCol);
+  if( rc==SQLITE_ROW ){
+    pCsr->iChunk = sqlite3_column_int64(pCsr->pChunk, 0);
+    pCsr->nRow = sqlite3_column_int(pCsr->pChunk, 1);
+    pCsr->iRow = 0;
+    return SQLITE_OK;
+  }
+  pCsr->bEof = 1;
+  return rc==SQLITE_DONE ? SQLITE_OK : rc;
+}
+
+static int columnarFilter(
+  sqlite3_vtab_cursor *cur,
+  int idxNum, const char *idxStr,
+  int argc, sqlite3_value **argv
+){
+  ColumnarCsr *pCsr = (ColumnarCsr*)cur;
+  ColumnarTab *pTab = (ColumnarTab*)cur->pVtab;
+  (void)idxNum; (void)idxStr; (void)argc; (void)argv;
+  sqlite3_reset(pCsr->pChunk);
+  pCsr->bEof = 0;
+  return columnarNextChunk(pCsr, pTab->nCol);
+}
+
+static int columnarNext(sqlite3_vtab_cursor *cur){
+  ColumnarCsr *pCsr = (ColumnarCsr*)cur;
+  ColumnarTab *pTab = (ColumnarTab*)cur->pVtab;
+  if( ++pCsr->iRow>=pCsr->nRow ){
+    return columnarNextChunk(pCsr, pTab->nCol);
+  }
+  return SQLITE_OK;
+}
+
+static int columnarEof(sqlite3_vtab_cursor *cur){
+  return ((ColumnarCsr*)cur)->bEof;
+}
+
+static int columnarColumn(
+  sqlite3_vtab_cursor *cur,
+  sqlite3_context *ctx,
+  int iCol
+){
+  ColumnarCsr *pCsr = (ColumnarCsr*)cur;
+  ColumnarBlob *p;
+  int rc;
+  const unsigned char *pFix;
+  int nRow = pCsr->nRow;
+
+  rc = columnarLoadCol(pCsr, iCol);
+  if( rc ) return rc;
+  p = &pCsr->aCol[iCol];
+  if( p->n < 9*nRow || pCsr->iRow>=nRow ) return SQLITE_CORRUPT_VTAB;
+  pFix = &p->a[nRow + 8*pCsr->iRow];
+  switch( p->a[pCsr->iRow] ){
+    case 1: {
+      sqlite3_int64 v;
+      memcpy(&v, pFix, 8);
+      sqlite3_result_int64(ctx, v);
+      break;
+    }
+    case 2: {
+      double r;
+      memcpy(&r, pFix, 8);
+      sqlite3_result_double(ctx, r);
+      break;
+    }
+    case 3:
+    case 4: {
+      unsigned int aOffLen[2];
+      memcpy(aOffLen, pFix, 8);
+      if( (sqlite3_int64)9*nRow+aOffLen[0]+aOffLen[1] > (unsigned)p->n ){
+        return SQLITE_CORRUPT_VTAB;
+      }
+      if( p->a[pCsr->iRow]==3 ){
+        sqlite3_result_text(ctx, (const char*)&p->a[9*nRow+aOffLen[0]],
+                            aOffLen[1], SQLITE_TRANSIENT);
+      }else{
+        sqlite3_result_blob(ctx, &p->a[9*nRow+aOffLen[0]],
+                            aOffLen[1], SQLITE_TRANSIENT);
+      }
+      break;
+    }
+    default:
+      sqlite3_result_null(ctx);
+      break;
+  }
+  return SQLITE_OK;
+}
+
+static int columnarRowid(sqlite3_vtab_cursor *cur, sqlite3_int64 *pRowid){
+  ColumnarCsr *pCsr = (ColumnarCsr*)cur;
+  ColumnarTab *pTab = (ColumnarTab*)cur->pVtab;
+  int rc = columnarLoadCol(pCsr, pTab->nCol);
+  if( rc==SQLITE_OK ){
+    ColumnarBlob *p = &pCsr->aCol[pTab->nCol];
+    if( p->n < 9*pCsr->nRow ) return SQLITE_CORRUPT_VTAB;
+    memcpy(pRowid, &p->a[pCsr->nRow + 8*pCsr->iRow], 8);
+  }
+  return rc;
+}
+
+static int columnarBestIndex(sqlite3_vtab *pVtab, sqlite3_index_info *pInfo){
+  /* Always a full scan; the benefit of the module is that only the
+  ** referenced columns' stripes are read. */
+  (void)pVtab;
+  pInfo->estimatedCost = 1e6;
+  pInfo->estimatedRows = 1000000;
+  return SQLITE_OK;
+}
+
+static sqlite3_module columnarModule = {
+  0,                         /* iVersion */
+  columnarCreate,            /* xCreate */
+  columnarConnect,           /* xConnect */
+  columnarBestIndex,         /* xBestIndex */
+  columnarDisconnect,        /* xDisconnect */
+  columnarDestroy,           /* xDestroy */
+  columnarOpen,              /* xOpen */
+  columnarClose,             /* xClose */
+  columnarFilter,            /* xFilter */
+  columnarNext,              /* xNext */
+  columnarEof,               /* xEof */
+  columnarColumn,            /* xColumn */
+  columnarRowid,             /* xRowid */
+  0,                         /* xUpdate - read only */
+  0,                         /* xBegin */
+  0,                         /* xSync */
+  0,                         /* xCommit */
+  0,                         /* xRollback */
+  0,                         /* xFindMethod */
+  0,                         /* xRename */
+  0,                         /* xSavepoint */
+  0,                         /* xRelease */
+  0,                         /* xRollbackTo */
+  0,                         /* xShadowName */
+  0                          /* xIntegrity */
+};
+
+#endif /* SQLITE_OMIT_VIRTUALTABLE */
+
+#ifdef _WIN32
+__declspec(dllexport)
+#endif
+int sqlite3_columnar_init(
+  sqlite3 *db,
+  char **pzErrMsg,
+  const sqlite3_api_routines *pApi
+){
+  int rc = SQLITE_OK;
+  SQLITE_EXTENSION_INIT2(pApi);
+  (void)pzErrMsg;
+#ifndef SQLITE_OMIT_VIRTUALTABLE
+  rc = sqlite3_create_module(db, "columnar", &columnarModule, 0);
+#endif
+  return rc;
+}
@@ -173,6 +173,10 @@ struct Rtree {
   u32 nNodeRef;               /* Number RtreeNodes with positive nRef */
   char *zReadAuxSql;          /* SQL for statement to read aux data */
 
+  i64 iLastInsert;            /* Leaf most recently inserted into, or 0 */
+  struct RtreeCell *pLastLeafBox; /* Bounding box of the cells on that leaf,
+                                  ** allocated on first use */
+
   /* List of nodes removed during a CondenseTree operation. List is
   ** linked together via the pointer normally used for hash chains -
   ** RtreeNode.pNext. RtreeNode.iNode stores the depth of the sub-tree 
@@ -286,6 +290,7 @@ struct RtreeCursor {
   u8 atEOF;                         /* True if at end of search */
   u8 bPoint;                        /* True if sPoint is valid */
   u8 bAuxValid;                     /* True if pReadAux is valid */
+  u8 bAllSimple;                    /* No RTREE_MATCH/RTREE_QUERY constraints */
   int iStrategy;                    /* Copy of idxNum search parameter */
   int nConstraint;                  /* Number of entries in aConstraint */
   RtreeConstraint *aConstraint;     /* Search constraints. */
@@ -1021,6 +1026,7 @@ static void rtreeReference(Rtree *pRtree){
 static void rtreeRelease(Rtree *pRtree){
   pRtree->nBusy--;
   if( pRtree->nBusy==0 ){
+    sqlite3_free(pRtree->pLastLeafBox);
     pRtree->inWrTrans = 0;
     assert( pRtree->nCursor==0 );
     nodeBlobReset(pRtree);
@@ -1609,6 +1615,66 @@ static void rtreeSearchPointPop(RtreeCursor *p){
 }
 
 
+
+/*
+** Evaluate every simple (non-callback) constraint in pCur against the
+** cell at pCellData, leaf and non-leaf variants in one pass.  The cell
+** coordinates are decoded once into a stack array - a single
+** byte-swapping sweep the compiler can vectorize - instead of once per
+** constraint through the pointer-chasing helpers above.  Only called
+** when RtreeCursor.bAllSimple is set.
+*/
+static int rtreeCellConstraintsSimple(
+  Rtree *pRtree,             /* The table */
+  RtreeCursor *pCur,         /* Cursor holding the constraints */
+  int eInt,                  /* True for integer coordinates */
+  int bLeaf,                 /* True if pCellData is a leaf cell */
+  u8 *pCellData              /* Raw cell content as it appears on disk */
+){
+  RtreeDValue aCoord[RTREE_MAX_DIMENSIONS*2];
+  int ii;
+  u8 *pData = pCellData + 8;
+  for(ii=0; ii<pRtree->nDim2; ii++){
+    RTREE_DECODE_COORD(eInt, pData, aCoord[ii]);
+    pData += 4;
+  }
+  for(ii=0; ii<pCur->nConstraint; ii++){
+    RtreeConstraint *p = pCur->aConstraint + ii;
+    if( bLeaf ){
+      RtreeDValue xN = aCoord[p->iCoord];
+      switch( p->op ){
+        case RTREE_TRUE:  continue;
+        case RTREE_FALSE: break;
+        case RTREE_LE:    if( xN <= p->u.rValue ) continue;  break;
+        case RTREE_LT:    if( xN <  p->u.rValue ) continue;  break;
+        case RTREE_GE:    if( xN >= p->u.rValue ) continue;  break;
+        case RTREE_GT:    if( xN >  p->u.rValue ) continue;  break;
+        default:          if( xN == p->u.rValue ) continue;  break;
+      }
+    }else{
+      int iLo = p->iCoord & 0xfe;
+      switch( p->op ){
+        case RTREE_TRUE:  continue;
+        case RTREE_FALSE: break;
+        case RTREE_EQ:
+          if( p->u.rValue>=aCoord[iLo] && p->u.rValue<=aCoord[iLo+1] ){
+            continue;
+          }
+          break;
+        case RTREE_LE:
+        case RTREE_LT:
+          if( p->u.rValue>=aCoord[iLo] ) continue;
+          break;
+        default:
+          if( p->u.rValue<=aCoord[iLo+1] ) continue;
+          break;
+      }
+    }
+    return NOT_WITHIN;
+  }
+  return FULLY_WITHIN;
+}
+
 /*
 ** Continue the search on cursor pCur until the front of the queue
 ** contains an entry suitable for returning as a result-set row,
@@ -1637,25 +1703,35 @@ static int rtreeStepToLeaf(RtreeCursor *pCur){
     pCellData = pNode->zData + (4+pRtree->nBytesPerCell*p->iCell);
     while( p->iCell<nCell ){
       sqlite3_rtree_dbl rScore = (sqlite3_rtree_dbl)-1;
-      eWithin = FULLY_WITHIN;
-      for(ii=0; ii<nConstraint; ii++){
-        RtreeConstraint *pConstraint = pCur->aConstraint + ii;
-        if( pConstraint->op>=RTREE_MATCH ){
-          rc = rtreeCallbackConstraint(pConstraint, eInt, pCellData, p,
-                                       &rScore, &eWithin);
-          if( rc ) return rc;
-        }else if( p->iLevel==1 ){
-          rtreeLeafConstraint(pConstraint, eInt, pCellData, &eWithin);
-        }else{
-          rtreeNonleafConstraint(pConstraint, eInt, pCellData, &eWithin);
-        }
+      if( pCur->bAllSimple && nConstraint>0 ){
+        eWithin = rtreeCellConstraintsSimple(pRtree, pCur, eInt,
+                                             p->iLevel==1, pCellData);
         if( eWithin==NOT_WITHIN ){
           p->iCell++;
           pCellData += pRtree->nBytesPerCell;
-          break;
+          continue;
+        }
+      }else{
+        eWithin = FULLY_WITHIN;
+        for(ii=0; ii<nConstraint; ii++){
+          RtreeConstraint *pConstraint = pCur->aConstraint + ii;
+          if( pConstraint->op>=RTREE_MATCH ){
+            rc = rtreeCallbackConstraint(pConstraint, eInt, pCellData, p,
+                                         &rScore, &eWithin);
+            if( rc ) return rc;
+          }else if( p->iLevel==1 ){
+            rtreeLeafConstraint(pConstraint, eInt, pCellData, &eWithin);
+          }else{
+            rtreeNonleafConstraint(pConstraint, eInt, pCellData, &eWithin);
+          }
+          if( eWithin==NOT_WITHIN ){
+            p->iCell++;
+            pCellData += pRtree->nBytesPerCell;
+            break;
+          }
         }
+        if( eWithin==NOT_WITHIN ) continue;
       }
-      if( eWithin==NOT_WITHIN ) continue;
       p->iCell++;
       x.iLevel = p->iLevel - 1;
       if( x.iLevel ){
@@ -1898,11 +1974,13 @@ static int rtreeFilter(
         memset(pCsr->anQueue, 0, sizeof(u32)*(pRtree->iDepth + 1));
         assert( (idxStr==0 && argc==0)
                 || (idxStr && (int)strlen(idxStr)==argc*2) );
+        pCsr->bAllSimple = 1;
         for(ii=0; ii<argc; ii++){
           RtreeConstraint *p = &pCsr->aConstraint[ii];
           int eType = sqlite3_value_numeric_type(argv[ii]);
           p->op = idxStr[ii*2];
           p->iCoord = idxStr[ii*2+1]-'0';
+          if( p->op>=RTREE_MATCH ) pCsr->bAllSimple = 0;
           if( p->op>=RTREE_MATCH ){
             /* A MATCH operator. The right-hand-side must be a blob that
             ** can be cast into an RtreeMatchArg object. One created using
@@ -2221,6 +2299,32 @@ static int ChooseLeaf(
   int rc;
   int ii;
   RtreeNode *pNode = 0;
+
+  /* Bulk loads mostly arrive sorted or tiled, so consecutive cells tend
+  ** to land on the same leaf.  If the new cell lies within the bounding
+  ** box of the cells already on the leaf used by the previous insert,
+  ** and that leaf still has room, reuse it and skip the root-to-leaf
+  ** descent: that box is covered by the leaf's parent cell, so no
+  ** ancestor bounding box needs adjusting either.  Any leaf is a legal
+  ** home for a cell, so this cannot hurt correctness, and the
+  ** containment test prevents it hurting tree quality.  The memory of
+  ** the last insert only lives within one write transaction. */
+  if( iHeight==0 && pRtree->iLastInsert
+   && pRtree->pLastLeafBox
+   && cellContains(pRtree, pRtree->pLastLeafBox, pCell)
+  ){
+    RtreeNode *pLast = 0;
+    if( nodeAcquire(pRtree, pRtree->iLastInsert, 0, &pLast)==SQLITE_OK
+     && pLast!=0
+     && NCELL(pLast)<((pRtree->iNodeSize-4)/pRtree->nBytesPerCell)
+    ){
+      *ppLeaf = pLast;
+      return SQLITE_OK;
+    }
+    nodeRelease(pRtree, pLast);
+    pRtree->iLastInsert = 0;
+  }
+
   rc = nodeAcquire(pRtree, 1, 0, &pNode);
 
   for(ii=0; rc==SQLITE_OK && ii<(pRtree->iDepth-iHeight); ii++){
@@ -2910,6 +3014,9 @@ static int rtreeDeleteRowid(Rtree *pRtree, sqlite3_int64 iDelete){
   int iCell;                      /* Index of iDelete cell in pLeaf */
   RtreeNode *pRoot = 0;           /* Root node of rtree structure */
 
+  /* The deleted cell may live on (or empty out) the memoized leaf, so
+  ** the fast insert path must forget it. */
+  pRtree->iLastInsert = 0;
 
   /* Obtain a reference to the root node to initialize Rtree.iDepth */
   rc = nodeAcquire(pRtree, 1, 0, &pRoot);
@@ -3191,7 +3298,34 @@ static int rtreeUpdate(
     }
     if( rc==SQLITE_OK ){
       int rc2;
+      int nCellPre = NCELL(pLeaf);
+      i64 iLeafNode = pLeaf->iNode;
       rc = rtreeInsertCell(pRtree, pLeaf, &cell, 0);
+      if( rc==SQLITE_OK
+       && nCellPre<((pRtree->iNodeSize-4)/pRtree->nBytesPerCell)
+      ){
+        /* The insert did not split the leaf: remember it for the
+        ** ChooseLeaf() fast path. */
+        if( pRtree->pLastLeafBox==0 ){
+          pRtree->pLastLeafBox = sqlite3_malloc(sizeof(RtreeCell));
+        }
+        if( pRtree->pLastLeafBox==0 ){
+          pRtree->iLastInsert = 0;
+        }else if( pRtree->iLastInsert==iLeafNode ){
+          cellUnion(pRtree, pRtree->pLastLeafBox, &cell);
+        }else{
+          int iC;
+          pRtree->iLastInsert = iLeafNode;
+          memcpy(pRtree->pLastLeafBox, &cell, sizeof(RtreeCell));
+          for(iC=0; iC<NCELL(pLeaf); iC++){
+            RtreeCell c2;
+            nodeGetCell(pRtree, pLeaf, iC, &c2);
+            cellUnion(pRtree, pRtree->pLastLeafBox, &c2);
+          }
+        }
+      }else{
+        pRtree->iLastInsert = 0;
+      }
       rc2 = nodeRelease(pRtree, pLeaf);
       if( rc==SQLITE_OK ){
         rc = rc2;
@@ -3220,6 +3354,7 @@ constraint:
 static int rtreeBeginTransaction(sqlite3_vtab *pVtab){
   Rtree *pRtree = (Rtree *)pVtab;
   assert( pRtree->inWrTrans==0 );
+  pRtree->iLastInsert = 0;
   pRtree->inWrTrans++;
   return SQLITE_OK;
 }
@@ -3231,6 +3366,7 @@ static int rtreeBeginTransaction(sqlite3_vtab *pVtab){
 static int rtreeEndTransaction(sqlite3_vtab *pVtab){
   Rtree *pRtree = (Rtree *)pVtab;
   pRtree->inWrTrans = 0;
+  pRtree->iLastInsert = 0;
   nodeBlobReset(pRtree);
   return SQLITE_OK;
 }
@@ -3281,6 +3417,20 @@ static int rtreeSavepoint(sqlite3_vtab *pVtab, int iSavepoint){
   return SQLITE_OK;
 }
 
+/*
+** The xRollbackTo method.  Reverting to a savepoint (including the
+** statement journals used by REPLACE and multi-row writes) may undo
+** inserts that established the last-insert leaf memo, leaving its node
+** id and cached bounding box describing state that no longer exists.
+** Forget the memo so the next insert walks from the root again.
+*/
+static int rtreeRollbackTo(sqlite3_vtab *pVtab, int iSavepoint){
+  Rtree *pRtree = (Rtree *)pVtab;
+  UNUSED_PARAMETER(iSavepoint);
+  pRtree->iLastInsert = 0;
+  return SQLITE_OK;
+}
+
 /*
 ** This function populates the pRtree->nRowEst variable with an estimate
 ** of the number of rows in the virtual table. If possible, this is based
@@ -3357,7 +3507,7 @@ static sqlite3_module rtreeModule = {
   rtreeRename,                /* xRename - rename the table */
   rtreeSavepoint,             /* xSavepoint */
   0,                          /* xRelease */
-  0,                          /* xRollbackTo */
+  rtreeRollbackTo,            /* xRollbackTo */
   rtreeShadowName,            /* xShadowName */
   rtreeIntegrity              /* xIntegrity */
 };
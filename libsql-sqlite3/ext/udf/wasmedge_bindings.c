@@ -4,16 +4,48 @@
 #include "wasm_bindings.h"
 #include <wasmedge/wasmedge.h>
 
+/*
+** A compiled module handle.  The VM is instantiated once, when the
+** module is compiled, instead of once per UDF invocation - per-call
+** instantiation re-validated and re-built the instance for every row,
+** which dominated the cost of calling a WASM UDF.  Keeping one live
+** instance is only safe if argument buffers handed to the module can
+** be released again, so bHasFree records whether the module exports
+** libsql_free(); modules without it fall back to the old
+** instantiate-per-call behavior, using re-instantiation as their
+** memory reset.
+*/
+typedef struct libsql_wasmedge_module {
+  WasmEdge_VMContext *ctx;
+  int bHasFree;                 /* Module exports libsql_free() */
+} libsql_wasmedge_module;
+
+/* Release an argument buffer inside the module's linear memory */
+static void libsqlWasmFreeArg(WasmEdge_VMContext *ctx, int iOffset){
+  WasmEdge_Value param[1];
+  WasmEdge_Value result[1];
+  WasmEdge_String zFree = WasmEdge_StringCreateByCString("libsql_free");
+  param[0] = WasmEdge_ValueGenI32(iOffset);
+  (void)WasmEdge_VMExecute(ctx, zFree, param, 1, result, 0);
+  WasmEdge_StringDelete(zFree);
+}
+
 void libsql_run_wasm(libsql_wasm_udf_api *api, sqlite3_context *context, libsql_wasm_engine_t *engine,
     libsql_wasm_module_t *module, const char *func_name, int argc, sqlite3_value **argv) {
 
-  WasmEdge_VMContext *ctx = (WasmEdge_VMContext *)module;
+  libsql_wasmedge_module *pMod = (libsql_wasmedge_module *)module;
+  WasmEdge_VMContext *ctx = pMod->ctx;
+  int aArgOffset[127];          /* Linear-memory offsets of boxed args */
+  int nArgOffset = 0;
 
-
-  WasmEdge_Result res = WasmEdge_VMInstantiate(ctx);
-  if (!WasmEdge_ResultOK(res)) {
-      sqlite3_result_error(context, "Instantiation failed", -1);
-      return;
+  WasmEdge_Result res;
+  if( !pMod->bHasFree ){
+    /* No way to release argument buffers: reset the whole instance */
+    res = WasmEdge_VMInstantiate(ctx);
+    if (!WasmEdge_ResultOK(res)) {
+        sqlite3_result_error(context, "Instantiation failed", -1);
+        return;
+    }
   }
 
   const WasmEdge_ModuleInstanceContext* instance_ctx = WasmEdge_VMGetActiveModule(ctx);
@@ -24,6 +56,9 @@ void libsql_run_wasm(libsql_wasm_udf_api *api, sqlite3_context *context, libsql_
   WasmEdge_Value params[argc];
   WasmEdge_Value results[1];
   WasmEdge_Value malloc_param[1];
+  /* One boundary-support string for the whole call, not one per boxed
+  ** argument */
+  WasmEdge_String zMalloc = WasmEdge_StringCreateByCString("libsql_malloc");
 
   int mem_size = WasmEdge_MemoryInstanceGetPageSize(mem_ctx) * 65536;
   int mem_offset = mem_size;
@@ -42,11 +77,10 @@ void libsql_run_wasm(libsql_wasm_udf_api *api, sqlite3_context *context, libsql_
       const char *text = sqlite3_value_text(argv[i]);
 
       malloc_param[0] = WasmEdge_ValueGenI32(text_len + 2);
-      WasmEdge_String wasmedge_func_name = WasmEdge_StringCreateByCString("libsql_malloc");
-      res = WasmEdge_VMExecute(ctx, wasmedge_func_name, malloc_param, 1, results, 1);
-      WasmEdge_StringDelete(wasmedge_func_name);
+      res = WasmEdge_VMExecute(ctx, zMalloc, malloc_param, 1, results, 1);
       if (!WasmEdge_ResultOK(res)) {
         sqlite3_result_error(context, "Execution failed", -1);
+        WasmEdge_StringDelete(zMalloc);
         return;
       }
       mem_offset = WasmEdge_ValueGetI32(results[0]);
@@ -56,6 +90,9 @@ void libsql_run_wasm(libsql_wasm_udf_api *api, sqlite3_context *context, libsql_
       memcpy(data + 1, text, text_len);
       data[1 + text_len] = '\0';
       params[i] = WasmEdge_ValueGenI32(mem_offset);
+      if (nArgOffset < (int)(sizeof(aArgOffset)/sizeof(aArgOffset[0]))) {
+        aArgOffset[nArgOffset++] = mem_offset;
+      }
       break;
     }
     case SQLITE_BLOB: {
@@ -63,11 +100,10 @@ void libsql_run_wasm(libsql_wasm_udf_api *api, sqlite3_context *context, libsql_
       const void *blob = sqlite3_value_blob(argv[i]);
       
       malloc_param[0] = WasmEdge_ValueGenI32(blob_len + 5);
-      WasmEdge_String wasmedge_func_name = WasmEdge_StringCreateByCString("libsql_malloc");
-      res = WasmEdge_VMExecute(ctx, wasmedge_func_name, malloc_param, 1, results, 1);
-      WasmEdge_StringDelete(wasmedge_func_name);
+      res = WasmEdge_VMExecute(ctx, zMalloc, malloc_param, 1, results, 1);
       if (!WasmEdge_ResultOK(res)) {
         sqlite3_result_error(context, "Execution failed", -1);
+        WasmEdge_StringDelete(zMalloc);
         return;
       }
       mem_offset = WasmEdge_ValueGetI32(results[0]);
@@ -77,16 +113,18 @@ void libsql_run_wasm(libsql_wasm_udf_api *api, sqlite3_context *context, libsql_
       sqlite3Put4byte(data + 1, blob_len);
       memcpy(data + 1 + 4, blob, blob_len);
       params[i] = WasmEdge_ValueGenI32(mem_offset);
+      if (nArgOffset < (int)(sizeof(aArgOffset)/sizeof(aArgOffset[0]))) {
+        aArgOffset[nArgOffset++] = mem_offset;
+      }
       break;
     }
     case SQLITE_NULL:
 
       malloc_param[0] = WasmEdge_ValueGenI32(1);
-      WasmEdge_String wasmedge_func_name = WasmEdge_StringCreateByCString("libsql_malloc");
-      res = WasmEdge_VMExecute(ctx, wasmedge_func_name, malloc_param, 1, results, 1);
-      WasmEdge_StringDelete(wasmedge_func_name);
+      res = WasmEdge_VMExecute(ctx, zMalloc, malloc_param, 1, results, 1);
       if (!WasmEdge_ResultOK(res)) {
         sqlite3_result_error(context, "Execution failed", -1);
+        WasmEdge_StringDelete(zMalloc);
         return;
       }
       mem_offset = WasmEdge_ValueGetI32(results[0]);
@@ -94,12 +132,22 @@ void libsql_run_wasm(libsql_wasm_udf_api *api, sqlite3_context *context, libsql_
       u8 *data = WasmEdge_MemoryInstanceGetPointer(mem_ctx, mem_offset, 1);
       data[0] = type;
       params[i] = WasmEdge_ValueGenI32(mem_offset);
+      if (nArgOffset < (int)(sizeof(aArgOffset)/sizeof(aArgOffset[0]))) {
+        aArgOffset[nArgOffset++] = mem_offset;
+      }
       break;
     }
   }
 
+  WasmEdge_StringDelete(zMalloc);
   WasmEdge_String wasmedge_func_name = WasmEdge_StringCreateByCString(func_name);
   res = WasmEdge_VMExecute(ctx, wasmedge_func_name, params, argc, results, 1);
+  if (pMod->bHasFree) {
+    int iArg;
+    for (iArg = 0; iArg < nArgOffset; iArg++) {
+      libsqlWasmFreeArg(ctx, aArgOffset[iArg]);
+    }
+  }
   if (!WasmEdge_ResultOK(res)) {
       sqlite3_result_error(context, "Execution failed", -1);
       WasmEdge_StringDelete(wasmedge_func_name);
@@ -167,7 +215,9 @@ void libsql_run_wasm(libsql_wasm_udf_api *api, sqlite3_context *context, libsql_
 }
 
 void libsql_free_wasm_module(void *ctx) {
-  WasmEdge_VMDelete(*(WasmEdge_VMContext **)ctx);
+  libsql_wasmedge_module *pMod = *(libsql_wasmedge_module **)ctx;
+  WasmEdge_VMDelete(pMod->ctx);
+  sqlite3_free(pMod);
 }
 
 libsql_wasm_engine_t *libsql_wasm_engine_new() {
@@ -204,7 +254,38 @@ libsql_wasm_module_t *libsql_compile_wasm_module(libsql_wasm_engine_t* engine, c
     *err_msg_buf = sqlite3_mprintf("Validation failed: %s", WasmEdge_ResultGetMessage(res));
     return NULL;
   }
-  return (libsql_wasm_module_t*)ctx;
+  {
+    libsql_wasmedge_module *pMod = sqlite3Malloc(sizeof(*pMod));
+    if (!pMod) {
+      *err_msg_buf = sqlite3_mprintf("Out of memory");
+      WasmEdge_VMDelete(ctx);
+      return NULL;
+    }
+    res = WasmEdge_VMInstantiate(ctx);
+    if (!WasmEdge_ResultOK(res)) {
+      *err_msg_buf = sqlite3_mprintf("Instantiation failed: %s",
+                                     WasmEdge_ResultGetMessage(res));
+      sqlite3_free(pMod);
+      WasmEdge_VMDelete(ctx);
+      return NULL;
+    }
+    pMod->ctx = ctx;
+    pMod->bHasFree = 0;
+    {
+      /* Probe for the optional libsql_free() export; see the comment on
+      ** libsql_wasmedge_module. */
+      const WasmEdge_ModuleInstanceContext *pInst =
+          WasmEdge_VMGetActiveModule(ctx);
+      if (pInst) {
+        WasmEdge_String zFree = WasmEdge_StringCreateByCString("libsql_free");
+        if (WasmEdge_ModuleInstanceFindFunction(pInst, zFree)) {
+          pMod->bHasFree = 1;
+        }
+        WasmEdge_StringDelete(zFree);
+      }
+    }
+    return (libsql_wasm_module_t*)pMod;
+  }
 }
 
 void libsql_wasm_free_msg_buf(char *err_msg_buf) {
@@ -621,6 +621,24 @@ ossshell$(EXE):	$(TOP)/test/ossfuzz.c $(TOP)/test/ossshell.c sqlite3.c sqlite3.h
 sessionfuzz$(EXE):	$(TOP)/test/sessionfuzz.c sqlite3.c sqlite3.h
 	$(TCC) -o sessionfuzz$(EXE) $(TOP)/test/sessionfuzz.c -lz $(TLIBS) $(THREADLIB)
 
+bench1$(EXE):	sqlite3.c $(TOP)/test/bench1.c
+	$(TCCX) -o bench1$(EXE) -I. $(TOP)/test/bench1.c sqlite3.c \
+		$(TLIBS) $(THREADLIB)
+
+# Build and run the micro-benchmark harness
+bench:	bench1$(EXE)
+	./bench1$(EXE)
+
+libsqlapitest$(EXE):	sqlite3.c $(TOP)/test/libsqlapitest.c \
+		$(TOP)/ext/misc/columnar.c $(TOP)/ext/misc/zonemap.c
+	$(TCCX) -o libsqlapitest$(EXE) -I. -DSQLITE_CORE \
+		$(TOP)/test/libsqlapitest.c $(TOP)/ext/misc/columnar.c \
+		$(TOP)/ext/misc/zonemap.c sqlite3.c $(TLIBS) $(THREADLIB)
+
+# Build and run the libsql C-API test harness
+apitest:	libsqlapitest$(EXE)
+	./libsqlapitest$(EXE)
+
 mptester$(EXE):	sqlite3.c $(TOP)/mptest/mptest.c
 	$(TCCX) -o $@ -I. $(TOP)/mptest/mptest.c sqlite3.c \
 		$(TLIBS) $(THREADLIB)
@@ -896,6 +914,10 @@ TESTFIXTURE_FLAGS += -DSQLITE_SERVER=1 -DSQLITE_PRIVATE="" -DSQLITE_CORE
 TESTFIXTURE_FLAGS += -DSQLITE_SERIES_CONSTRAINT_VERIFY=1
 TESTFIXTURE_FLAGS += -DSQLITE_DEFAULT_PAGE_SIZE=1024
 TESTFIXTURE_FLAGS += -DSQLITE_ENABLE_STMTVTAB
+TESTFIXTURE_FLAGS += -DSQLITE_ENABLE_WAL_COMPRESSION
+TESTFIXTURE_FLAGS += -DSQLITE_ENABLE_CLOCK_PCACHE
+TESTFIXTURE_FLAGS += -DSQLITE_ENABLE_SUPERINSTRUCTIONS
+TESTFIXTURE_FLAGS += -DSQLITE_ENABLE_IOURING
 TESTFIXTURE_FLAGS += -DSQLITE_ENABLE_DBPAGE_VTAB
 TESTFIXTURE_FLAGS += -DSQLITE_ENABLE_BYTECODE_VTAB
 TESTFIXTURE_FLAGS += -DTCLSH_INIT_PROC=sqlite3TestInit
@@ -391,6 +391,18 @@ int sqlite3_backup_step(sqlite3_backup *p, int nPage){
       const Pgno iSrcPg = p->iNext;                 /* Source page number */
       if( iSrcPg!=PENDING_BYTE_PAGE(p->pSrc->pBt) ){
         DbPage *pSrcPg;                             /* Source page object */
+        if( (iSrcPg&0x1f)==1 ){
+          /* The backup reads the source strictly sequentially, so tell
+          ** the OS about the next stretch of pages before faulting on
+          ** them one at a time.  One hint per 32 pages keeps the
+          ** syscall cost negligible. */
+          Pgno iPf;
+          Pgno iLast = iSrcPg+32;
+          if( iLast>(Pgno)nSrcPage ) iLast = (Pgno)nSrcPage;
+          for(iPf=iSrcPg; iPf<=iLast; iPf+=8){
+            sqlite3PagerPrefetch(pSrcPager, iPf);
+          }
+        }
         rc = sqlite3PagerGet(pSrcPager, iSrcPg, &pSrcPg,PAGER_GET_READONLY);
         if( rc==SQLITE_OK ){
           rc = backupOnePage(p, iSrcPg, sqlite3PagerGetData(pSrcPg), 0);
@@ -1120,6 +1120,21 @@ static int ptrmapGet(BtShared *pBt, Pgno key, u8 *pEType, Pgno *pPgno){
 #define findCellPastPtr(P,I) \
   ((P)->aDataOfst + ((P)->maskPage & get2byteAligned(&(P)->aCellIdx[2*(I)])))
 
+/*
+** Hint to the hardware prefetcher that cell iCell of page P is about to
+** be accessed.  The in-page binary search loops use this to fetch both
+** possible next-probe cells while the current cell is still being
+** compared, hiding the cache-miss latency that otherwise dominates
+** lookups on pages with thousands of cells.  The computed address is
+** masked by maskPage, so a hint on a corrupt page is harmless.
+*/
+#if defined(__GNUC__)
+# define btreePrefetchCell(P,I) \
+    __builtin_prefetch(findCellPastPtr((P),(I)), 0, 1)
+#else
+# define btreePrefetchCell(P,I)
+#endif
+
 
 /*
 ** This is common tail processing for btreeParseCellPtr() and
@@ -4156,6 +4171,14 @@ static int autoVacuumCommit(Btree *p){
       if( nVac==0 ){
         return SQLITE_OK;
       }
+    }else if( db->nAutovacPageLimit>0 ){
+      /* PRAGMA autovacuum_pages: SQL-level equivalent of an
+      ** sqlite3_autovacuum_pages() callback that caps the number of
+      ** pages reclaimed per commit, so large deletes do not stall
+      ** their own transaction relocating the whole freelist. */
+      nVac = (Pgno)db->nAutovacPageLimit;
+      if( nVac>nFree ) nVac = nFree;
+      if( nVac==0 ) return SQLITE_OK;
     }else{
       nVac = nFree;
     }
@@ -5092,14 +5115,21 @@ static int accessPayload(
       memset(pCur->aOverflow, 0, nOvfl*sizeof(Pgno));
       pCur->curFlags |= BTCF_ValidOvfl;
     }else{
-      /* If the overflow page-list cache has been allocated and the
-      ** entry for the first required overflow page is valid, skip
-      ** directly to it.
+      /* If the overflow page-list cache has been allocated, skip ahead
+      ** to the closest cached page at or before the target.  Even when
+      ** the exact entry is not yet known, a partially populated cache
+      ** (from earlier shallower reads) saves re-walking the prefix of
+      ** the chain: scanning back through the in-memory array costs
+      ** nothing next to the page fetches it avoids.
       */
-      if( pCur->aOverflow[offset/ovflSize] ){
-        iIdx = (offset/ovflSize);
+      u32 iTarget = (u32)(offset/ovflSize);
+      iIdx = (int)iTarget;
+      while( iIdx>0 && pCur->aOverflow[iIdx]==0 ) iIdx--;
+      if( pCur->aOverflow[iIdx] ){
         nextPage = pCur->aOverflow[iIdx];
-        offset = (offset%ovflSize);
+        offset -= (u32)iIdx*ovflSize;
+      }else{
+        iIdx = 0;
       }
     }
 
@@ -5175,6 +5205,13 @@ static int accessPayload(
           if( rc==SQLITE_OK ){
             aPayload = sqlite3PagerGetData(pDbPage);
             nextPage = get4byte(aPayload);
+            if( eOp==0 && amt-a>0 && nextPage ){
+              /* The stream continues on another overflow page whose
+              ** number is now known: hint it to the OS before spending
+              ** time on the copy, so sequential blob streaming overlaps
+              ** the next fault with this memcpy. */
+              sqlite3PagerPrefetch(pBt->pPager, nextPage);
+            }
             rc = copyPayload(&aPayload[offset+4], pBuf, a, eOp, pDbPage);
             sqlite3PagerUnref(pDbPage);
             offset = 0;
@@ -5426,6 +5463,7 @@ static int moveToRoot(BtCursor *pCur){
   MemPage *pRoot;
   int rc = SQLITE_OK;
 
+  pCur->nSeqScan = 0;
   assert( cursorOwnsBtShared(pCur) );
   assert( CURSOR_INVALID < CURSOR_REQUIRESEEK );
   assert( CURSOR_VALID   < CURSOR_REQUIRESEEK );
@@ -5729,6 +5767,12 @@ int sqlite3BtreeTableMoveto(
     for(;;){
       i64 nCellKey;
       pCell = findCellPastPtr(pPage, idx);
+      if( upr-lwr>=8 ){
+        /* Fetch both possible next midpoint cells while the current
+        ** key is being decoded and compared. */
+        btreePrefetchCell(pPage, (lwr+idx-1)>>1);
+        btreePrefetchCell(pPage, (idx+1+upr)>>1);
+      }
       if( pPage->intKeyLeaf ){
         while( 0x80 <= *(pCell++) ){
           if( pCell>=pPage->aDataEnd ){
@@ -5972,6 +6016,12 @@ bypass_moveto_root:
     for(;;){
       int nCell;  /* Size of the pCell cell in bytes */
       pCell = findCellPastPtr(pPage, idx);
+      if( upr-lwr>=8 ){
+        /* Fetch both possible next midpoint cells while the current
+        ** record is being compared. */
+        btreePrefetchCell(pPage, (lwr+idx-1)>>1);
+        btreePrefetchCell(pPage, (idx+1+upr)>>1);
+      }
 
       /* The maximum supported page-size is 65536 bytes. This means that
       ** the maximum number of record bytes stored on an index B-Tree
@@ -6165,6 +6215,41 @@ i64 sqlite3BtreeRowCountEst(BtCursor *pCur){
 ** is a hint to the implement.  SQLite btree implementation does not use
 ** this hint, but COMDB2 does.
 */
+
+/* Number of upcoming sibling leaf pages covered by read-ahead hints */
+#define BTREE_SCAN_PREFETCH 8
+
+/*
+** The cursor has just finished a leaf page during a forward scan and
+** pPage is the interior page being advanced, with pCur->ix referring to
+** the child that will be visited next.  Issue read-ahead hints for the
+** children a little ahead of the scan position, so that a cold
+** sequential scan keeps the device busy instead of faulting leaf pages
+** in one at a time.  Hints are only issued for positions not already
+** covered on this page, so steady-state scans send one hint per leaf.
+*/
+static void btreePrefetchSiblings(BtCursor *pCur, MemPage *pPage){
+  int iFirst = pCur->ix + 1;
+  int iLast = pCur->ix + BTREE_SCAN_PREFETCH;
+  int i;
+  assert( !pPage->leaf );
+  if( pPage->pgno==pCur->pgnoPrefetch && iFirst<=(int)pCur->ixPrefetch+1 ){
+    iFirst = pCur->ixPrefetch + 1;
+  }
+  if( iLast>pPage->nCell ) iLast = pPage->nCell;
+  for(i=iFirst; i<=iLast; i++){
+    Pgno pgno;
+    if( i==pPage->nCell ){
+      pgno = get4byte(&pPage->aData[pPage->hdrOffset+8]);
+    }else{
+      pgno = get4byte(findCell(pPage, i));
+    }
+    sqlite3PagerPrefetch(pCur->pBt->pPager, pgno);
+  }
+  pCur->pgnoPrefetch = pPage->pgno;
+  pCur->ixPrefetch = (u16)iLast;
+}
+
 static SQLITE_NOINLINE int btreeNext(BtCursor *pCur){
   int rc;
   int idx;
@@ -6207,6 +6292,11 @@ static SQLITE_NOINLINE int btreeNext(BtCursor *pCur){
       moveToParent(pCur);
       pPage = pCur->pPage;
     }while( pCur->ix>=pPage->nCell );
+    if( pCur->nSeqScan<2 ){
+      pCur->nSeqScan++;
+    }else if( !pPage->leaf ){
+      btreePrefetchSiblings(pCur, pPage);
+    }
     if( pPage->intKey ){
       return sqlite3BtreeNext(pCur, 0);
     }else{
@@ -7923,6 +8013,104 @@ static int balance_quick(MemPage *pParent, MemPage *pPage, u8 *pSpace){
 
   return rc;
 }
+
+/*
+** This version of balance_quick() is used for append-inserts into index
+** (non-intkey) b-trees, and only when the cursor carries the
+** BTREE_BULKLOAD hint - i.e. for sorted bulk loads such as the
+** sorter-fed CREATE INDEX path.  The situation is the same as for
+** balance_quick(): pPage is the right-most leaf, it is overfull, and the
+** single overflow cell is the largest key in the tree.
+**
+** A new right sibling of pPage is allocated and the overflow cell moved
+** onto it.  Unlike table b-trees, index b-trees store real keys on
+** interior pages, so the divider inserted into pParent is the last cell
+** of pPage, which is removed from the leaf and rewritten into pParent
+** with a child pointer to pPage prepended.  pPage itself is left
+** completely full, which is exactly what a bulk load wants and why this
+** path is not used for random inserts.
+**
+** pSpace points to a buffer of at least pBt->pageSize bytes that holds
+** the divider cell while pParent is (possibly) being rebalanced.  The
+** caller owns it and must keep it alive until pParent has been
+** rebalanced, exactly as for the pSpace buffer of balance_nonroot().
+*/
+static int balance_quick_index(MemPage *pParent, MemPage *pPage, u8 *pSpace){
+  BtShared *const pBt = pPage->pBt;    /* B-Tree Database */
+  MemPage *pNew;                       /* Newly allocated page */
+  int rc;                              /* Return Code */
+  Pgno pgnoNew;                        /* Page number of pNew */
+
+  assert( sqlite3_mutex_held(pPage->pBt->mutex) );
+  assert( sqlite3PagerIswriteable(pParent->pDbPage) );
+  assert( pPage->nOverflow==1 );
+  assert( pPage->leaf && !pPage->intKey );
+
+  if( pPage->nCell==0 ) return SQLITE_CORRUPT_BKPT;
+  assert( pPage->nFree>=0 );
+  assert( pParent->nFree>=0 );
+
+  rc = allocateBtreePage(pBt, &pNew, &pgnoNew, 0, 0);
+  if( rc==SQLITE_OK ){
+
+    u8 *pCell = pPage->apOvfl[0];
+    u16 szCell = pPage->xCellSize(pPage, pCell);
+    u8 *pLast;                         /* Last cell of pPage: the divider */
+    u16 szLast;
+    CellArray b;
+
+    assert( sqlite3PagerIswriteable(pNew->pDbPage) );
+    assert( CORRUPT_DB || pPage->aData[0]==(PTF_ZERODATA|PTF_LEAF) );
+    zeroPage(pNew, PTF_ZERODATA|PTF_LEAF);
+    b.nCell = 1;
+    b.pRef = pPage;
+    b.apCell = &pCell;
+    b.szCell = &szCell;
+    b.apEnd[0] = pPage->aDataEnd;
+    b.ixNx[0] = 2;
+    rc = rebuildPage(&b, 0, 1, pNew);
+    if( NEVER(rc) ){
+      releasePage(pNew);
+      return rc;
+    }
+    pNew->nFree = pBt->usableSize - pNew->cellOffset - 2 - szCell;
+
+    if( ISAUTOVACUUM(pBt) ){
+      ptrmapPut(pBt, pgnoNew, PTRMAP_BTREE, pParent->pgno, &rc);
+      if( szCell>pNew->minLocal ){
+        ptrmapPutOvflPtr(pNew, pNew, pCell, &rc);
+      }
+    }
+
+    /* Move the last cell of pPage up into pParent as the divider.  The
+    ** first 4 bytes of pSpace are filled in with the child pointer by
+    ** insertCell(). */
+    pLast = findCell(pPage, pPage->nCell-1);
+    szLast = pPage->xCellSize(pPage, pLast);
+    if( (u32)szLast+4>pBt->usableSize ){
+      rc = SQLITE_CORRUPT_PAGE(pPage);
+    }else{
+      memcpy(&pSpace[4], pLast, szLast);
+      dropCell(pPage, pPage->nCell-1, szLast, &rc);
+      if( rc==SQLITE_OK ){
+        rc = insertCell(pParent, pParent->nCell, pSpace, szLast+4,
+                        0, pPage->pgno);
+      }
+      if( rc==SQLITE_OK && ISAUTOVACUUM(pBt) && szLast>pPage->minLocal ){
+        /* The divider's overflow chain, if any, now hangs off pParent */
+        ptrmapPutOvflPtr(pParent, pPage, &pSpace[4], &rc);
+      }
+    }
+
+    /* Set the right-child pointer of pParent to point to the new page. */
+    put4byte(&pParent->aData[pParent->hdrOffset+8], pgnoNew);
+
+    /* Release the reference to the new page. */
+    releasePage(pNew);
+  }
+
+  return rc;
+}
 #endif /* SQLITE_OMIT_QUICKBALANCE */
 
 #if 0
@@ -8998,11 +9186,12 @@ static int balance(BtCursor *pCur){
       }
       if( rc==SQLITE_OK ){
 #ifndef SQLITE_OMIT_QUICKBALANCE
-        if( pPage->intKeyLeaf
+        if( pPage->leaf
          && pPage->nOverflow==1
          && pPage->aiOvfl[0]==pPage->nCell
          && pParent->pgno!=1
          && pParent->nCell==iIdx
+         && (pPage->intKey || (pCur->hints & BTREE_BULKLOAD)!=0)
         ){
           /* Call balance_quick() to create a new sibling of pPage on which
           ** to store the overflow cell. balance_quick() inserts a new cell
@@ -9019,7 +9208,21 @@ static int balance(BtCursor *pCur){
           */
           assert( balance_quick_called==0 );
           VVA_ONLY( balance_quick_called++ );
-          rc = balance_quick(pParent, pPage, aBalanceQuickSpace);
+          if( pPage->intKeyLeaf ){
+            rc = balance_quick(pParent, pPage, aBalanceQuickSpace);
+          }else{
+            /* Bulk-load append into an index b-tree.  The divider cell
+            ** buffer follows the same lifetime rules as the pSpace
+            ** buffer of balance_nonroot() below. */
+            u8 *pSpace = sqlite3PageMalloc(pCur->pBt->pageSize);
+            if( pSpace==0 ){
+              rc = SQLITE_NOMEM_BKPT;
+            }else{
+              rc = balance_quick_index(pParent, pPage, pSpace);
+              if( pFree ) sqlite3PageFree(pFree);
+              pFree = pSpace;
+            }
+          }
         }else
 #endif
         {
@@ -229,6 +229,23 @@
 #define MX_CELL(pBt) ((pBt->pageSize-8)/6)
 
 /* Forward declarations */
+
+/* A note covering three recurring storage-format requests:
+**
+**   - Prefix-compressed index pages (shared-prefix elision per page)
+**   - Sub-page delta journaling (dirty byte ranges instead of pages)
+**   - Pager-level page compression with variable-size extents
+**
+** All three change the on-disk contract: cell parsing, the fixed
+** page-number -> file-offset mapping, or the WAL frame format that
+** every reader (including crash recovery and external tooling)
+** depends on.  They are only implementable behind a new file-format
+** version, not as incremental patches to btree.c/pager.c; until such
+** a version exists, the supported levers are page_size selection,
+** the compressed-WAL build option for log traffic, and compressing
+** VFS shims for at-rest size.
+*/
+
 typedef struct MemPage MemPage;
 typedef struct BtLock BtLock;
 typedef struct CellInfo CellInfo;
@@ -544,6 +561,9 @@ struct BtCursor {
   i8 iPage;                 /* Index of current page in apPage */
   u8 curIntKey;             /* Value of apPage[0]->intKey */
   u16 ix;                   /* Current index for apPage[iPage] */
+  u8 nSeqScan;              /* Consecutive forward leaf transitions */
+  u16 ixPrefetch;           /* Last child index hinted on page pgnoPrefetch */
+  Pgno pgnoPrefetch;        /* Interior page the last read-ahead hint was on */
   u16 aiIdx[BTCURSOR_MAX_DEPTH-1];     /* Current index in apPage[i] */
   struct KeyInfo *pKeyInfo;            /* Arg passed to comparison function */
   MemPage *pPage;                        /* Current page */
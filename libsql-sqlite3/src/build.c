@@ -5154,6 +5154,15 @@ void sqlite3BeginTransaction(Parse *pParse, int type){
         eTxnType = 0;  /* Read txn */
       }else if( type==TK_EXCLUSIVE ){
         eTxnType = 2;  /* Exclusive txn */
+      }else if( type==TK_IMMEDIATE && (db->flags & SQLITE_ConcurrentWr)!=0 ){
+        /* Under PRAGMA concurrent_writes the WAL write lock is normally
+        ** deferred until commit.  At the pager level an IMMEDIATE
+        ** transaction is indistinguishable from a lazy write upgrade, so
+        ** pass it down as an exclusive request here - BEGIN IMMEDIATE
+        ** exists to reserve the lock up front, and the deferral would
+        ** otherwise turn it into a commit-time SQLITE_BUSY_SNAPSHOT.
+        ** See sqlite3PagerBegin(). */
+        eTxnType = 2;
       }else{
         eTxnType = 1;  /* Write txn */
       }
@@ -211,6 +211,9 @@ static const char * const sqlite3azCompileOpt[] = {
 #ifdef SQLITE_ENABLE_CEROD
   "ENABLE_CEROD=" CTIMEOPT_VAL(SQLITE_ENABLE_CEROD),
 #endif
+#ifdef SQLITE_ENABLE_CLOCK_PCACHE
+  "ENABLE_CLOCK_PCACHE",
+#endif
 #ifdef SQLITE_ENABLE_COLUMN_METADATA
   "ENABLE_COLUMN_METADATA",
 #endif
@@ -262,6 +265,9 @@ static const char * const sqlite3azCompileOpt[] = {
 #ifdef SQLITE_ENABLE_IOTRACE
   "ENABLE_IOTRACE",
 #endif
+#ifdef SQLITE_ENABLE_IOURING
+  "ENABLE_IOURING",
+#endif
 #ifdef SQLITE_ENABLE_LOAD_EXTENSION
   "ENABLE_LOAD_EXTENSION",
 #endif
@@ -328,6 +334,9 @@ static const char * const sqlite3azCompileOpt[] = {
 #ifdef SQLITE_ENABLE_STMT_SCANSTATUS
   "ENABLE_STMT_SCANSTATUS",
 #endif
+#ifdef SQLITE_ENABLE_SUPERINSTRUCTIONS
+  "ENABLE_SUPERINSTRUCTIONS",
+#endif
 #ifdef SQLITE_ENABLE_TREETRACE
   "ENABLE_TREETRACE",
 #endif
@@ -346,6 +355,9 @@ static const char * const sqlite3azCompileOpt[] = {
 #ifdef SQLITE_ENABLE_VFSTRACE
   "ENABLE_VFSTRACE",
 #endif
+#ifdef SQLITE_ENABLE_WAL_COMPRESSION
+  "ENABLE_WAL_COMPRESSION",
+#endif
 #ifdef SQLITE_ENABLE_WHERETRACE
   "ENABLE_WHERETRACE",
 #endif
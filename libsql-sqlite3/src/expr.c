@@ -1033,9 +1033,15 @@ Expr *sqlite3PExpr(
   Expr *pRight            /* Right operand */
 ){
   Expr *p;
-  p = sqlite3DbMallocRawNN(pParse->db, sizeof(Expr));
+  p = (Expr*)sqlite3ParseArenaAlloc(pParse, sizeof(Expr));
   if( p ){
     memset(p, 0, sizeof(Expr));
+    p->flags = EP_Arena;
+  }else{
+    p = sqlite3DbMallocRawNN(pParse->db, sizeof(Expr));
+    if( p ) memset(p, 0, sizeof(Expr));
+  }
+  if( p ){
     p->op = op & 0xff;
     p->iAgg = -1;
     sqlite3ExprAttachSubtrees(pParse->db, p, pLeft, pRight);
@@ -1399,7 +1405,7 @@ static SQLITE_NOINLINE void sqlite3ExprDeleteNN(sqlite3 *db, Expr *p){
 #endif
     }
   }
-  if( !ExprHasProperty(p, EP_Static) ){
+  if( !ExprHasProperty(p, EP_Static|EP_Arena) ){
     sqlite3DbNNFreeNN(db, p);
   }
 }
@@ -1647,8 +1653,9 @@ static Expr *exprDup(
       nNewSize = EXPR_FULLSIZE;
     }
 
-    /* Set the EP_Reduced, EP_TokenOnly, and EP_Static flags appropriately. */
-    pNew->flags &= ~(EP_Reduced|EP_TokenOnly|EP_Static);
+    /* Set the EP_Reduced, EP_TokenOnly, and EP_Static flags appropriately.
+    ** EP_Arena is cleared as well: the copy is an ordinary allocation. */
+    pNew->flags &= ~(EP_Reduced|EP_TokenOnly|EP_Static|EP_Arena);
     pNew->flags |= nStructSize & (EP_Reduced|EP_TokenOnly);
     pNew->flags |= staticFlag;
     ExprClearVVAProperties(pNew);
@@ -3303,6 +3310,7 @@ void sqlite3CodeRhsOfIN(
   int iTab                /* Use this cursor number */
 ){
   int addrOnce = 0;           /* Address of the OP_Once instruction at top */
+
   int addr;                   /* Address of OP_OpenEphemeral instruction */
   Expr *pLeft;                /* the LHS of the IN operator */
   KeyInfo *pKeyInfo = 0;      /* Key information */
@@ -3311,6 +3319,7 @@ void sqlite3CodeRhsOfIN(
 
   v = pParse->pVdbe;
   assert( v!=0 );
+  pParse->regInFilter = 0;
 
   /* The evaluation of the IN must be repeated every time it
   ** is encountered if any of the following is true:
@@ -3390,9 +3399,26 @@ void sqlite3CodeRhsOfIN(
       SelectDest dest;
       int i;
       int rc;
+      int regFilter = 0;
+      int bBinary = 1;
       sqlite3SelectDestInit(&dest, SRT_Set, iTab);
       dest.zAffSdst = exprINAffinity(pParse, pExpr);
       pSelect->iLimit = 0;
+      /* Build a Bloom filter over the RHS so that probes which miss can
+      ** skip the ephemeral index seek.  The filter hashes raw register
+      ** bytes, so it is only sound when every key column compares with
+      ** the binary collation. */
+      for(i=0; i<nVal; i++){
+        Expr *pL = sqlite3VectorFieldSubexpr(pLeft, i);
+        CollSeq *pColl = sqlite3BinaryCompareCollSeq(
+            pParse, pL, pEList->a[i].pExpr);
+        if( pColl && !sqlite3IsBinary(pColl) ) bBinary = 0;
+      }
+      if( bBinary ){
+        regFilter = ++pParse->nMem;
+        sqlite3VdbeAddOp2(v, OP_Blob, 10000, regFilter);
+        dest.iSDParm2 = regFilter;
+      }
       testcase( pSelect->selFlags & SF_Distinct );
       testcase( pKeyInfo==0 ); /* Caused by OOM in sqlite3KeyInfoAlloc() */
       pCopy = sqlite3SelectDup(pParse->db, pSelect, 0);
@@ -3413,6 +3439,7 @@ void sqlite3CodeRhsOfIN(
             pParse, p, pEList->a[i].pExpr
         );
       }
+      pParse->regInFilter = regFilter;
     }
   }else if( ALWAYS(pExpr->x.pList!=0) ){
     /* Case 2:     expr IN (exprlist)
@@ -3689,6 +3716,7 @@ static void sqlite3ExprCodeIN(
   int destNotNull;      /* Jump here if a comparison is not true in step 6 */
   int addrTop;          /* Top of the step-6 loop */
   int iTab = 0;         /* Index to use */
+  int regInFilter;      /* Bloom filter over the RHS, or 0 */
   u8 okConstFactor = pParse->okConstFactor;
 
   assert( !ExprHasVVAProperty(pExpr,EP_Immutable) );
@@ -3712,6 +3740,12 @@ static void sqlite3ExprCodeIN(
                              IN_INDEX_MEMBERSHIP | IN_INDEX_NOOP_OK,
                              destIfFalse==destIfNull ? 0 : &rRhsHasNull,
                              aiMap, &iTab);
+  /* Filter created by sqlite3CodeRhsOfIN() for this RHS, if any.
+  ** FindInIndex() may not have called CodeRhsOfIN() at all (reusing an
+  ** existing index), in which case CodeRhsOfIN() was never entered and
+  ** regInFilter must not be inherited from an unrelated IN. */
+  regInFilter = (eType==IN_INDEX_EPH) ? pParse->regInFilter : 0;
+  pParse->regInFilter = 0;
 
   assert( pParse->nErr || nVector==1 || eType==IN_INDEX_EPH
        || eType==IN_INDEX_INDEX_ASC || eType==IN_INDEX_INDEX_DESC
@@ -3840,6 +3874,12 @@ static void sqlite3ExprCodeIN(
   }else{
     sqlite3VdbeAddOp4(v, OP_Affinity, rLhs, nVector, 0, zAff, nVector);
     if( destIfFalse==destIfNull ){
+      if( regInFilter ){
+        /* Probe the RHS Bloom filter first: a miss proves the value is
+        ** absent and skips the ephemeral index seek */
+        sqlite3VdbeAddOp4Int(v, OP_Filter, regInFilter, destIfFalse,
+                             rLhs, nVector); VdbeCoverage(v);
+      }
       /* Combine Step 3 and Step 5 into a single opcode */
       sqlite3VdbeAddOp4Int(v, OP_NotFound, iTab, destIfFalse,
                            rLhs, nVector); VdbeCoverage(v);
@@ -896,6 +896,57 @@ int sqlite3_like_count = 0;
 #endif
 
 
+/*
+** Fast path for the common "contains" shape - LIKE '%needle%' and
+** GLOB '*needle*' with a metacharacter-free ASCII needle.  Returns
+** SQLITE_MATCH or SQLITE_NOMATCH like patternCompare(), or -1 when
+** the pattern does not have this shape and the general matcher must
+** run.  Restricting the needle to ASCII keeps the byte-wise scan
+** equivalent to the character-wise matcher: an ASCII needle cannot
+** match in the middle of a multi-byte UTF-8 character, and LIKE's
+** case folding applies to ASCII only.
+*/
+static int patternCompareContains(
+  const u8 *zPattern,             /* The pattern */
+  const u8 *zString,              /* The string to compare against */
+  const struct compareInfo *pInfo /* Match rules */
+){
+  int nPat, nLit, nStr, i;
+  const u8 *zLit;
+  u8 aFold[64];
+
+  if( zPattern[0]!=pInfo->matchAll ) return -1;
+  for(nPat=1; zPattern[nPat]; nPat++){
+    u8 c = zPattern[nPat];
+    if( c>=0x80
+     || c==pInfo->matchOne
+     || (pInfo->matchSet!=0 && c==pInfo->matchSet)
+     || (c==pInfo->matchAll && zPattern[nPat+1]!=0)
+    ){
+      return -1;
+    }
+  }
+  if( nPat<2 || zPattern[nPat-1]!=pInfo->matchAll ) return -1;
+  zLit = &zPattern[1];
+  nLit = nPat-2;
+  if( nLit==0 ) return SQLITE_MATCH;
+  if( nLit>(int)sizeof(aFold) ) return -1;
+  for(i=0; i<nLit; i++){
+    aFold[i] = pInfo->noCase ? sqlite3UpperToLower[zLit[i]] : zLit[i];
+  }
+  nStr = sqlite3Strlen30((const char*)zString);
+  for(i=0; i+nLit<=nStr; i++){
+    int j;
+    for(j=0; j<nLit; j++){
+      u8 cs = zString[i+j];
+      if( pInfo->noCase && cs<0x80 ) cs = sqlite3UpperToLower[cs];
+      if( cs!=aFold[j] ) break;
+    }
+    if( j==nLit ) return SQLITE_MATCH;
+  }
+  return SQLITE_NOMATCH;
+}
+
 /*
 ** Implementation of the like() SQL function.  This function implements
 ** the built-in LIKE operator.  The first argument to the function is the
@@ -966,11 +1017,17 @@ static void likeFunc(
   zB = sqlite3_value_text(argv[0]);
   zA = sqlite3_value_text(argv[1]);
   if( zA && zB ){
+    int res = -1;
 #ifdef SQLITE_TEST
     sqlite3_like_count++;
 #endif
-    sqlite3_result_int(context,
-                      patternCompare(zB, zA, pInfo, escape)==SQLITE_MATCH);
+    if( argc==2 ){
+      res = patternCompareContains(zB, zA, pInfo);
+    }
+    if( res<0 ){
+      res = patternCompare(zB, zA, pInfo, escape);
+    }
+    sqlite3_result_int(context, res==SQLITE_MATCH);
   }
 }
 
@@ -1499,7 +1499,28 @@ json_parse_restart:
     jnFlags = 0;
   parse_string:
     cDelim = z[i];
-    for(j=i+1; 1; j++){
+    j = i+1;
+    if( pParse->nJson>0 ){
+      /* Skip runs of ordinary string bytes eight at a time.  A "stop"
+      ** byte is anything that jsonIsOk[] maps to zero: control
+      ** characters, either quote character, or a backslash.  The SWAR
+      ** test never reads past nJson, and any word containing a stop
+      ** byte is re-examined by the byte loop below. */
+      static const u64 ONES = 0x0101010101010101LL;
+      static const u64 HIGH = 0x8080808080808080LL;
+      while( j+8<=(u32)pParse->nJson ){
+        u64 v;
+        u64 m;
+        memcpy(&v, &z[j], 8);
+        m = ((v - ONES*0x20) & ~v)               /* Bytes less than 0x20 */
+          | (((v ^ (ONES*'"')) - ONES) & ~(v ^ (ONES*'"')))
+          | (((v ^ (ONES*'\'')) - ONES) & ~(v ^ (ONES*'\'')))
+          | (((v ^ (ONES*'\\')) - ONES) & ~(v ^ (ONES*'\\')));
+        if( m & HIGH ) break;
+        j += 8;
+      }
+    }
+    for(; 1; j++){
       if( jsonIsOk[(unsigned char)z[j]] ) continue;
       c = z[j];
       if( c==cDelim ){
@@ -1853,7 +1874,201 @@ static int jsonParseFindParents(JsonParse *pParse){
 #define JSON_CACHE_ID  (-429938)  /* First cache entry */
 #define JSON_CACHE_SZ  4          /* Max number of cache entries */
 
+/**************************************************************************
+** Binary JSON ("jsonb")
+**
+** jsonb(X) serializes the parse tree of X into a BLOB so that later
+** calls to the JSON functions can rebuild the JsonParse object without
+** re-parsing the text.  The blob layout is:
+**
+**     bytes 0..3     magic "JSB1"
+**     bytes 4..7     number of nodes (big-endian)
+**     bytes 8..11    length of the JSON text, in bytes (big-endian)
+**     then           12 bytes per node:
+**                      eType(1) jnFlags(1) eU(1) zero(1) n(4) v(4)
+**     then           the original JSON text, NUL terminated
+**
+** For nodes with eU==1, v is the offset of the content within the JSON
+** text; otherwise v is zero.  Only unedited parses are serialized, so
+** edit-related node flags and JSON_SUBST nodes never appear.  The
+** decoder validates every field before use, since blobs may come from
+** untrusted databases.
+*/
+#define JSONB_MAGIC     "JSB1"
+#define JSONB_HDRSIZE   12
+#define JSONB_NODESIZE  12
+/* jnFlags bits that may legitimately appear in a serialized node */
+#define JSONB_OKFLAGS   (JNODE_RAW|JNODE_ESCAPE|JNODE_LABEL|JNODE_JSON5)
+
+static JsonParse *jsonParseCached(sqlite3_context*,sqlite3_value*,sqlite3_context*,int);
+
+static void jsonbPut32(u8 *a, u32 v){
+  a[0] = (u8)(v>>24); a[1] = (u8)(v>>16); a[2] = (u8)(v>>8); a[3] = (u8)v;
+}
+static u32 jsonbGet32(const u8 *a){
+  return ((u32)a[0]<<24) | ((u32)a[1]<<16) | ((u32)a[2]<<8) | (u32)a[3];
+}
+
 /*
+** If pVal is a framed jsonb blob, return a pointer to its content and
+** set *pnNode and *pnText to the node count and embedded text length.
+** Return NULL if pVal is not a jsonb blob.  This checks the framing
+** only; per-node validation happens in jsonbDecodeNodes().
+*/
+static const u8 *jsonbBlob(sqlite3_value *pVal, u32 *pnNode, u32 *pnText){
+  const u8 *aBlob;
+  sqlite3_int64 nBlob;
+  u32 nNode, nText;
+  if( sqlite3_value_type(pVal)!=SQLITE_BLOB ) return 0;
+  nBlob = sqlite3_value_bytes(pVal);
+  if( nBlob<JSONB_HDRSIZE+JSONB_NODESIZE+1 ) return 0;
+  aBlob = (const u8*)sqlite3_value_blob(pVal);
+  if( aBlob==0 || memcmp(aBlob, JSONB_MAGIC, 4)!=0 ) return 0;
+  nNode = jsonbGet32(&aBlob[4]);
+  nText = jsonbGet32(&aBlob[8]);
+  if( nNode==0 || nNode>0x7fffffff/JSONB_NODESIZE ) return 0;
+  if( nBlob!=JSONB_HDRSIZE + (sqlite3_int64)nNode*JSONB_NODESIZE + nText + 1 ){
+    return 0;
+  }
+  if( aBlob[nBlob-1]!=0 ) return 0;
+  *pnNode = nNode;
+  *pnText = nText;
+  return aBlob;
+}
+
+/*
+** Populate pParse->aNode[] from the node records in a jsonb blob.
+** pParse->zJson/nJson have already been initialized with the embedded
+** text.  Returns non-zero if the blob is malformed.
+*/
+static int jsonbDecodeNodes(JsonParse *pParse, const u8 *aBlob, u32 nNode){
+  u32 i;
+  JsonNode *aNode;
+  aNode = (JsonNode*)sqlite3_malloc64( (u64)nNode*sizeof(JsonNode) );
+  if( aNode==0 ){
+    pParse->oom = 1;
+    return 1;
+  }
+  memset(aNode, 0, (u64)nNode*sizeof(JsonNode));
+  for(i=0; i<nNode; i++){
+    const u8 *a = &aBlob[JSONB_HDRSIZE + i*JSONB_NODESIZE];
+    JsonNode *pNode = &aNode[i];
+    u32 v = jsonbGet32(&a[8]);
+    pNode->eType = a[0];
+    pNode->jnFlags = a[1];
+    pNode->eU = a[2];
+    pNode->n = jsonbGet32(&a[4]);
+    if( pNode->eType<JSON_NULL ) goto decode_malformed;
+    if( pNode->eType<JSON_NULL || pNode->eType>JSON_OBJECT ) goto decode_malformed;
+    if( pNode->jnFlags & ~JSONB_OKFLAGS ) goto decode_malformed;
+    if( pNode->eU != (pNode->eType>=JSON_INT && pNode->eType<=JSON_STRING) ){
+      goto decode_malformed;
+    }
+    if( pNode->eU==1 ){
+      if( (u64)v+pNode->n > (u64)pParse->nJson ) goto decode_malformed;
+      if( pNode->n==0
+       && (pNode->eType!=JSON_STRING || (pNode->jnFlags & JNODE_RAW)==0)
+      ){
+        /* Empty content is only meaningful for raw strings (an empty SQL
+        ** text value from json_object() or similar); the renderer needs
+        ** at least one byte for every other scalar. */
+        goto decode_malformed;
+      }
+      pNode->u.zJContent = pParse->zJson + v;
+    }else if( v!=0 ){
+      goto decode_malformed;
+    }
+    if( pNode->eType>=JSON_ARRAY && (u64)i+1+pNode->n > nNode ){
+      goto decode_malformed;
+    }
+  }
+
+  /* Second pass: verify that the children of every container lie wholly
+  ** within that container and, for objects, form label/value pairs.  The
+  ** rendering and lookup code walk containers with jsonNodeSize() and
+  ** read pNode[j+1] for object values, so both properties must hold
+  ** before anything else trusts the nodes. */
+  for(i=0; i<nNode; i++){
+    JsonNode *pNode = &aNode[i];
+    u32 j = 1;
+    if( pNode->eType<JSON_ARRAY ) continue;
+    if( pNode->eType==JSON_ARRAY ){
+      while( j<=pNode->n ){
+        j += jsonNodeSize(&aNode[i+j]);
+      }
+    }else{
+      while( j<=pNode->n ){
+        if( aNode[i+j].eType!=JSON_STRING ) goto decode_malformed;
+        if( j+1>pNode->n ) goto decode_malformed;
+        j += 1 + jsonNodeSize(&aNode[i+j+1]);
+      }
+    }
+    if( j!=pNode->n+1 ) goto decode_malformed;
+  }
+  pParse->aNode = aNode;
+  pParse->nNode = nNode;
+  pParse->nAlloc = nNode;
+  return 0;
+
+decode_malformed:
+  sqlite3_free(aNode);
+  return 1;
+}
+
+/*
+** Implementation of the jsonb(X) function: return the binary
+** serialization of X.  X may be JSON text or an existing jsonb blob.
+*/
+static void jsonbFunc(
+  sqlite3_context *ctx,
+  int argc,
+  sqlite3_value **argv
+){
+  JsonParse *p;           /* The parse */
+  sqlite3_int64 nOut;
+  u8 *aOut;
+  u32 i;
+  UNUSED_PARAMETER(argc);
+  p = jsonParseCached(ctx, argv[0], ctx, 1);
+  if( p==0 ) return;
+  assert( p->hasMod==0 );
+  nOut = JSONB_HDRSIZE + (sqlite3_int64)p->nNode*JSONB_NODESIZE + p->nJson + 1;
+  aOut = (u8*)sqlite3_malloc64( nOut );
+  if( aOut==0 ){
+    sqlite3_result_error_nomem(ctx);
+    return;
+  }
+  memcpy(aOut, JSONB_MAGIC, 4);
+  jsonbPut32(&aOut[4], p->nNode);
+  jsonbPut32(&aOut[8], p->nJson);
+  for(i=0; i<p->nNode; i++){
+    JsonNode *pNode = &p->aNode[i];
+    u8 *a = &aOut[JSONB_HDRSIZE + i*JSONB_NODESIZE];
+    /* JsonNode.eU is only maintained in SQLITE_DEBUG builds, so derive
+    ** the content flag from the node type: INT, REAL and STRING nodes
+    ** carry text content, nothing else does in an unedited parse. */
+    int bContent = pNode->eType>=JSON_INT && pNode->eType<=JSON_STRING;
+    a[0] = pNode->eType;
+    a[1] = pNode->jnFlags & JSONB_OKFLAGS;
+    a[2] = (u8)bContent;
+    a[3] = 0;
+    jsonbPut32(&a[4], pNode->n);
+    if( bContent ){
+      assert( pNode->u.zJContent>=p->zJson
+           && pNode->u.zJContent<=&p->zJson[p->nJson] );
+      jsonbPut32(&a[8], (u32)(pNode->u.zJContent - p->zJson));
+    }else{
+      jsonbPut32(&a[8], 0);
+    }
+  }
+  memcpy(&aOut[JSONB_HDRSIZE + (sqlite3_int64)p->nNode*JSONB_NODESIZE],
+         p->zJson, p->nJson);
+  aOut[nOut-1] = 0;
+  sqlite3_result_blob64(ctx, aOut, (u64)nOut, sqlite3_free);
+}
+
+/*
+
 ** Obtain a complete parse of the JSON found in the pJson argument
 **
 ** Use the sqlite3_get_auxdata() cache to find a preexisting parse
@@ -1887,8 +2102,11 @@ static JsonParse *jsonParseCached(
   sqlite3_context *pErrCtx,      /* Write parse errors here if not NULL */
   int bUnedited                  /* No prior edits allowed */
 ){
-  char *zJson = (char*)sqlite3_value_text(pJson);
-  int nJson = sqlite3_value_bytes(pJson);
+  char *zJson;
+  int nJson;
+  const u8 *aBlob;               /* Serialized jsonb content, or NULL */
+  u32 nNodeBlob = 0;             /* Number of nodes in aBlob */
+  u32 nTextBlob = 0;             /* Length of the text embedded in aBlob */
   JsonParse *p;
   JsonParse *pMatch = 0;
   int iKey;
@@ -1897,6 +2115,16 @@ static JsonParse *jsonParseCached(
   u32 iMaxHold = 0;
   int bJsonRCStr;
 
+  aBlob = jsonbBlob(pJson, &nNodeBlob, &nTextBlob);
+  if( aBlob ){
+    /* A jsonb blob: the cache is searched using the embedded text, so a
+    ** blob and its text form share cache entries. */
+    zJson = (char*)&aBlob[JSONB_HDRSIZE + nNodeBlob*JSONB_NODESIZE];
+    nJson = (int)nTextBlob;
+  }else{
+    zJson = (char*)sqlite3_value_text(pJson);
+    nJson = sqlite3_value_bytes(pJson);
+  }
   if( zJson==0 ) return 0;
   for(iKey=0; iKey<JSON_CACHE_SZ; iKey++){
     p = (JsonParse*)sqlite3_get_auxdata(pCtx, JSON_CACHE_ID+iKey);
@@ -1942,7 +2170,7 @@ static JsonParse *jsonParseCached(
   /* The input JSON was not found anywhere in the cache.  We will need
   ** to parse it ourselves and generate a new JsonParse object.
   */
-  bJsonRCStr = sqlite3ValueIsOfClass(pJson,sqlite3RCStrUnref);
+  bJsonRCStr = aBlob==0 && sqlite3ValueIsOfClass(pJson,sqlite3RCStrUnref);
   p = sqlite3_malloc64( sizeof(*p) + (bJsonRCStr ? 0 : nJson+1) );
   if( p==0 ){
     sqlite3_result_error_nomem(pCtx);
@@ -1957,6 +2185,22 @@ static JsonParse *jsonParseCached(
     memcpy(p->zJson, zJson, nJson+1);
   }
   p->nJPRef = 1;
+  if( aBlob ){
+    p->nJson = nJson;
+    if( jsonbDecodeNodes(p, aBlob, nNodeBlob) ){
+      if( pErrCtx==0 ){
+        p->nErr = 1;
+        return p;
+      }
+      if( p->oom ){
+        sqlite3_result_error_nomem(pErrCtx);
+      }else{
+        sqlite3_result_error(pErrCtx, "malformed JSON", -1);
+      }
+      jsonParseFree(p);
+      return 0;
+    }
+  }else
   if( jsonParse(p, pErrCtx) ){
     if( pErrCtx==0 ){
       p->nErr = 1;
@@ -3658,27 +3902,49 @@ static int jsonEachFilter(
   JsonEachCursor *p = (JsonEachCursor*)cur;
   const char *z;
   const char *zRoot = 0;
-  sqlite3_int64 n;
+  sqlite3_int64 n = 0;
+  const u8 *aBlob;               /* Serialized jsonb content, or NULL */
+  u32 nNodeBlob = 0;             /* Number of nodes in aBlob */
+  u32 nTextBlob = 0;             /* Length of the text embedded in aBlob */
 
   UNUSED_PARAMETER(idxStr);
   UNUSED_PARAMETER(argc);
   jsonEachCursorReset(p);
   if( idxNum==0 ) return SQLITE_OK;
-  z = (const char*)sqlite3_value_text(argv[0]);
-  if( z==0 ) return SQLITE_OK;
   memset(&p->sParse, 0, sizeof(p->sParse));
   p->sParse.nJPRef = 1;
-  if( sqlite3ValueIsOfClass(argv[0], sqlite3RCStrUnref) ){
+  aBlob = jsonbBlob(argv[0], &nNodeBlob, &nTextBlob);
+  if( aBlob ){
+    z = (const char*)&aBlob[JSONB_HDRSIZE + nNodeBlob*JSONB_NODESIZE];
+    n = nTextBlob;
+  }else{
+    z = (const char*)sqlite3_value_text(argv[0]);
+    if( z==0 ) return SQLITE_OK;
+  }
+  if( aBlob==0 && sqlite3ValueIsOfClass(argv[0], sqlite3RCStrUnref) ){
     p->sParse.zJson = sqlite3RCStrRef((char*)z);
   }else{
-    n = sqlite3_value_bytes(argv[0]);
+    if( aBlob==0 ) n = sqlite3_value_bytes(argv[0]);
     p->sParse.zJson = sqlite3RCStrNew( n+1 );
     if( p->sParse.zJson==0 ) return SQLITE_NOMEM;
     memcpy(p->sParse.zJson, z, (size_t)n+1);
   }
   p->sParse.bJsonIsRCStr = 1;
   p->zJson = p->sParse.zJson;
-  if( jsonParse(&p->sParse, 0) ){
+  if( aBlob ){
+    p->sParse.nJson = (int)n;
+    if( jsonbDecodeNodes(&p->sParse, aBlob, nNodeBlob) ){
+      int rc = SQLITE_NOMEM;
+      if( p->sParse.oom==0 ){
+        sqlite3_free(cur->pVtab->zErrMsg);
+        cur->pVtab->zErrMsg = sqlite3_mprintf("malformed JSON");
+        if( cur->pVtab->zErrMsg ) rc = SQLITE_ERROR;
+      }
+      jsonEachCursorReset(p);
+      return rc;
+    }
+  }
+  if( aBlob==0 && jsonParse(&p->sParse, 0) ){
     int rc = SQLITE_NOMEM;
     if( p->sParse.oom==0 ){
       sqlite3_free(cur->pVtab->zErrMsg);
@@ -3805,6 +4071,7 @@ void sqlite3RegisterJsonFunctions(void){
 #ifndef SQLITE_OMIT_JSON
   static FuncDef aJsonFunc[] = {
     JFUNCTION(json,               1, 0,  jsonRemoveFunc),
+    JFUNCTION(jsonb,              1, 0,  jsonbFunc),
     JFUNCTION(json_array,        -1, 0,  jsonArrayFunc),
     JFUNCTION(json_array_length,  1, 0,  jsonArrayLengthFunc),
     JFUNCTION(json_array_length,  2, 0,  jsonArrayLengthFunc),
@@ -793,6 +793,7 @@ static int setupLookaside(sqlite3 *db, void *pBuf, int sz, int cnt){
   void *pStart;
   sqlite3_int64 szAlloc = sz*(sqlite3_int64)cnt;
   int nBig;   /* Number of full-size slots */
+  int nMid;   /* Number of LOOKASIDE_MID-byte slots */
   int nSm;    /* Number smaller LOOKASIDE_SMALL-byte slots */
  
   if( sqlite3LookasideUsed(db,0)>0 ){
@@ -823,19 +824,27 @@ static int setupLookaside(sqlite3 *db, void *pBuf, int sz, int cnt){
     pStart = pBuf;
   }
 #ifndef SQLITE_OMIT_TWOSIZE_LOOKASIDE
-  if( sz>=LOOKASIDE_SMALL*3 ){
+  if( sz>=LOOKASIDE_MID*3 ){
+    /* Budget one mid-size slot and two small slots per full-size slot,
+    ** then fill the tail of the buffer with more small slots */
+    nBig = szAlloc/(LOOKASIDE_MID+2*LOOKASIDE_SMALL+sz);
+    nMid = nBig;
+    nSm = (szAlloc - (sz+LOOKASIDE_MID)*(sqlite3_int64)nBig)/LOOKASIDE_SMALL;
+  }else if( sz>=LOOKASIDE_SMALL*3 ){
     nBig = szAlloc/(3*LOOKASIDE_SMALL+sz);
+    nMid = 0;
     nSm = (szAlloc - sz*nBig)/LOOKASIDE_SMALL;
   }else if( sz>=LOOKASIDE_SMALL*2 ){
     nBig = szAlloc/(LOOKASIDE_SMALL+sz);
+    nMid = 0;
     nSm = (szAlloc - sz*nBig)/LOOKASIDE_SMALL;
   }else
 #endif /* SQLITE_OMIT_TWOSIZE_LOOKASIDE */
   if( sz>0 ){
     nBig = szAlloc/sz;
-    nSm = 0;
+    nMid = nSm = 0;
   }else{
-    nBig = nSm = 0;
+    nBig = nMid = nSm = 0;
   }
   db->lookaside.pStart = pStart;
   db->lookaside.pInit = 0;
@@ -853,9 +862,17 @@ static int setupLookaside(sqlite3 *db, void *pBuf, int sz, int cnt){
       p = (LookasideSlot*)&((u8*)p)[sz];
     }
 #ifndef SQLITE_OMIT_TWOSIZE_LOOKASIDE
+    db->lookaside.pMidInit = 0;
+    db->lookaside.pMidFree = 0;
     db->lookaside.pSmallInit = 0;
     db->lookaside.pSmallFree = 0;
     db->lookaside.pMiddle = p;
+    for(i=0; i<nMid; i++){
+      p->pNext = db->lookaside.pMidInit;
+      db->lookaside.pMidInit = p;
+      p = (LookasideSlot*)&((u8*)p)[LOOKASIDE_MID];
+    }
+    db->lookaside.pSmallStart = p;
     for(i=0; i<nSm; i++){
       p->pNext = db->lookaside.pSmallInit;
       db->lookaside.pSmallInit = p;
@@ -866,13 +883,16 @@ static int setupLookaside(sqlite3 *db, void *pBuf, int sz, int cnt){
     db->lookaside.pEnd = p;
     db->lookaside.bDisable = 0;
     db->lookaside.bMalloced = pBuf==0 ?1:0;
-    db->lookaside.nSlot = nBig+nSm;
+    db->lookaside.nSlot = nBig+nMid+nSm;
   }else{
     db->lookaside.pStart = 0;
 #ifndef SQLITE_OMIT_TWOSIZE_LOOKASIDE
+    db->lookaside.pMidInit = 0;
+    db->lookaside.pMidFree = 0;
     db->lookaside.pSmallInit = 0;
     db->lookaside.pSmallFree = 0;
     db->lookaside.pMiddle = 0;
+    db->lookaside.pSmallStart = 0;
 #endif /* SQLITE_OMIT_TWOSIZE_LOOKASIDE */
     db->lookaside.pEnd = 0;
     db->lookaside.bDisable = 1;
@@ -1096,7 +1116,7 @@ static int nocaseCollatingFunc(
   int nKey1, const void *pKey1,
   int nKey2, const void *pKey2
 ){
-  int r = sqlite3StrNICmp(
+  int r = sqlite3StrNICmpBounded(
       (const char *)pKey1, (const char *)pKey2, (nKey1<nKey2)?nKey1:nKey2);
   UNUSED_PARAMETER(NotUsed);
   if( 0==r ){
@@ -1279,6 +1299,10 @@ static int sqlite3Close(sqlite3 *db, int forceZombie){
   */
   sqlite3VtabRollback(db);
 
+  /* Cached idle statements would otherwise read as unfinalized
+  ** statements and block the close. */
+  sqlite3StmtCacheClear(db);
+
   /* Legacy behavior (sqlite3_close() behavior) is to return
   ** SQLITE_BUSY if the connection can not be closed immediately.
   */
@@ -2401,6 +2425,80 @@ void *sqlite3_preupdate_hook(
 }
 #endif /* SQLITE_ENABLE_PREUPDATE_HOOK */
 
+/*
+** libsql extension: read the WAL frame number of the snapshot a fresh
+** read transaction on schema zDb (or "main" if NULL) would observe.
+** Pairs with sqlite3_wal_hook(), whose callback receives the same
+** counter after each commit, to implement read-your-writes across a
+** connection pool: the writer publishes the frame number from its
+** commit hook and readers wait for it below.  Only supported with the
+** built-in WAL implementation; returns SQLITE_MISUSE otherwise, and
+** SQLITE_ERROR if the database is not in WAL mode.
+*/
+int libsql_wal_frame(sqlite3 *db, const char *zDb, unsigned int *pnFrame){
+  int rc;
+  int iDb;
+  Btree *pBt;
+  int bOpenedTrans = 0;
+
+#ifdef SQLITE_ENABLE_API_ARMOR
+  if( !sqlite3SafetyCheckOk(db) || pnFrame==0 ) return SQLITE_MISUSE_BKPT;
+#endif
+  sqlite3_mutex_enter(db->mutex);
+  iDb = zDb ? sqlite3FindDbName(db, zDb) : 0;
+  if( iDb<0 || (pBt = db->aDb[iDb].pBt)==0 ){
+    sqlite3_mutex_leave(db->mutex);
+    return SQLITE_ERROR;
+  }
+  sqlite3BtreeEnter(pBt);
+  if( sqlite3BtreeTxnState(pBt)==SQLITE_TXN_NONE ){
+    rc = sqlite3BtreeBeginTrans(pBt, 0, 0);
+    bOpenedTrans = 1;
+  }else{
+    rc = SQLITE_OK;
+  }
+  if( rc==SQLITE_OK ){
+    libsql_wal *pWal = sqlite3PagerWal(sqlite3BtreePager(pBt));
+    if( pWal==0 ){
+      rc = SQLITE_ERROR;        /* Not in WAL mode */
+    }else{
+      rc = libsql_wal_frame_count(pWal, pnFrame);
+    }
+  }
+  if( bOpenedTrans ){
+    sqlite3BtreeCommit(pBt);
+  }
+  sqlite3BtreeLeave(pBt);
+  sqlite3_mutex_leave(db->mutex);
+  return rc;
+}
+
+/*
+** libsql extension: block until a fresh read transaction on zDb would
+** observe WAL frame mnFrame or later, or until roughly nTimeoutMs
+** milliseconds have passed (SQLITE_BUSY).  If the connection already
+** holds a transaction its snapshot is frozen, so the wait degenerates
+** into a single check.
+*/
+int libsql_wal_wait_frame(
+  sqlite3 *db,
+  const char *zDb,
+  unsigned int mnFrame,
+  int nTimeoutMs
+){
+  int rc;
+  sqlite3_int64 nRemainUs = (sqlite3_int64)(nTimeoutMs<0 ? 0 : nTimeoutMs)*1000;
+  for(;;){
+    unsigned int nFrame = 0;
+    rc = libsql_wal_frame(db, zDb, &nFrame);
+    if( rc!=SQLITE_OK ) return rc;
+    if( nFrame>=mnFrame ) return SQLITE_OK;
+    if( db->autoCommit==0 || nRemainUs<=0 ) return SQLITE_BUSY;
+    sqlite3OsSleep(db->pVfs, 1000);
+    nRemainUs -= 1000;
+  }
+}
+
 /*
 ** Register a callback to be invoked when the connection is closed.
 */
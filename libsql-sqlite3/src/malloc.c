@@ -349,7 +349,9 @@ int sqlite3MallocSize(const void *p){
 }
 static int lookasideMallocSize(sqlite3 *db, const void *p){
 #ifndef SQLITE_OMIT_TWOSIZE_LOOKASIDE    
-  return p<db->lookaside.pMiddle ? db->lookaside.szTrue : LOOKASIDE_SMALL;
+  if( p<db->lookaside.pMiddle ) return db->lookaside.szTrue;
+  if( p<db->lookaside.pSmallStart ) return LOOKASIDE_MID;
+  return LOOKASIDE_SMALL;
 #else
   return db->lookaside.szTrue;
 #endif  
@@ -370,7 +372,10 @@ int sqlite3DbMallocSize(sqlite3 *db, const void *p){
 #ifndef SQLITE_OMIT_TWOSIZE_LOOKASIDE
       if( ((uptr)p)>=(uptr)(db->lookaside.pMiddle) ){
         assert( sqlite3_mutex_held(db->mutex) );
-        return LOOKASIDE_SMALL;
+        if( ((uptr)p)>=(uptr)(db->lookaside.pSmallStart) ){
+          return LOOKASIDE_SMALL;
+        }
+        return LOOKASIDE_MID;
       }
 #endif
       if( ((uptr)p)>=(uptr)(db->lookaside.pStart) ){
@@ -427,11 +432,19 @@ void sqlite3DbFreeNN(sqlite3 *db, void *p){
       if( ((uptr)p)>=(uptr)(db->lookaside.pMiddle) ){
         LookasideSlot *pBuf = (LookasideSlot*)p;
         assert( db->pnBytesFreed==0 );
+        if( ((uptr)p)>=(uptr)(db->lookaside.pSmallStart) ){
 #ifdef SQLITE_DEBUG
-        memset(p, 0xaa, LOOKASIDE_SMALL);  /* Trash freed content */
+          memset(p, 0xaa, LOOKASIDE_SMALL);  /* Trash freed content */
 #endif
-        pBuf->pNext = db->lookaside.pSmallFree;
-        db->lookaside.pSmallFree = pBuf;
+          pBuf->pNext = db->lookaside.pSmallFree;
+          db->lookaside.pSmallFree = pBuf;
+        }else{
+#ifdef SQLITE_DEBUG
+          memset(p, 0xaa, LOOKASIDE_MID);  /* Trash freed content */
+#endif
+          pBuf->pNext = db->lookaside.pMidFree;
+          db->lookaside.pMidFree = pBuf;
+        }
         return;
       }
 #endif /* SQLITE_OMIT_TWOSIZE_LOOKASIDE */
@@ -466,11 +479,19 @@ void sqlite3DbNNFreeNN(sqlite3 *db, void *p){
     if( ((uptr)p)>=(uptr)(db->lookaside.pMiddle) ){
       LookasideSlot *pBuf = (LookasideSlot*)p;
       assert( db->pnBytesFreed==0 );
+      if( ((uptr)p)>=(uptr)(db->lookaside.pSmallStart) ){
 #ifdef SQLITE_DEBUG
-      memset(p, 0xaa, LOOKASIDE_SMALL);  /* Trash freed content */
+        memset(p, 0xaa, LOOKASIDE_SMALL);  /* Trash freed content */
 #endif
-      pBuf->pNext = db->lookaside.pSmallFree;
-      db->lookaside.pSmallFree = pBuf;
+        pBuf->pNext = db->lookaside.pSmallFree;
+        db->lookaside.pSmallFree = pBuf;
+      }else{
+#ifdef SQLITE_DEBUG
+        memset(p, 0xaa, LOOKASIDE_MID);  /* Trash freed content */
+#endif
+        pBuf->pNext = db->lookaside.pMidFree;
+        db->lookaside.pMidFree = pBuf;
+      }
       return;
     }
 #endif /* SQLITE_OMIT_TWOSIZE_LOOKASIDE */
@@ -668,6 +689,17 @@ void *sqlite3DbMallocRawNN(sqlite3 *db, u64 n){
       return (void*)pBuf;
     }
   }
+  if( n<=LOOKASIDE_MID ){
+    if( (pBuf = db->lookaside.pMidFree)!=0 ){
+      db->lookaside.pMidFree = pBuf->pNext;
+      db->lookaside.anStat[0]++;
+      return (void*)pBuf;
+    }else if( (pBuf = db->lookaside.pMidInit)!=0 ){
+      db->lookaside.pMidInit = pBuf->pNext;
+      db->lookaside.anStat[0]++;
+      return (void*)pBuf;
+    }
+  }
 #endif
   if( (pBuf = db->lookaside.pFree)!=0 ){
     db->lookaside.pFree = pBuf->pNext;
@@ -704,8 +736,10 @@ void *sqlite3DbRealloc(sqlite3 *db, void *p, u64 n){
   assert( sqlite3_mutex_held(db->mutex) );
   if( ((uptr)p)<(uptr)db->lookaside.pEnd ){
 #ifndef SQLITE_OMIT_TWOSIZE_LOOKASIDE
-    if( ((uptr)p)>=(uptr)db->lookaside.pMiddle ){
+    if( ((uptr)p)>=(uptr)db->lookaside.pSmallStart ){
       if( n<=LOOKASIDE_SMALL ) return p;
+    }else if( ((uptr)p)>=(uptr)db->lookaside.pMiddle ){
+      if( n<=LOOKASIDE_MID ) return p;
     }else
 #endif
     if( ((uptr)p)>=(uptr)db->lookaside.pStart ){
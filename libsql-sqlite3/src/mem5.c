@@ -123,6 +123,11 @@ static SQLITE_WSD struct Mem5Global {
   */
   int aiFreelist[LOGMAX+1];
 
+  /* Bit i of freeMask is set if and only if aiFreelist[i] is non-empty.
+  ** Lets the allocator find the smallest usable free list with one
+  ** count-trailing-zeros step instead of a linear scan. */
+  u32 freeMask;
+
   /*
   ** Space for tracking which blocks are checked out and the size
   ** of each block.  One byte per block.
@@ -156,6 +161,7 @@ static void memsys5Unlink(int i, int iLogsize){
   prev = MEM5LINK(i)->prev;
   if( prev<0 ){
     mem5.aiFreelist[iLogsize] = next;
+    if( next<0 ) mem5.freeMask &= ~(1u<<iLogsize);
   }else{
     MEM5LINK(prev)->next = next;
   }
@@ -182,6 +188,7 @@ static void memsys5Link(int i, int iLogsize){
     MEM5LINK(x)->prev = i;
   }
   mem5.aiFreelist[iLogsize] = i;
+  mem5.freeMask |= (1u<<iLogsize);
 }
 
 /*
@@ -243,9 +250,18 @@ static void *memsys5MallocUnsafe(int nByte){
 
   /* Make sure mem5.aiFreelist[iLogsize] contains at least one free
   ** block.  If not, then split a block of the next larger power of
-  ** two in order to create a new free block of size iLogsize.
+  ** two in order to create a new free block of size iLogsize.  The
+  ** freeMask bitmap locates the smallest non-empty list in one step.
   */
-  for(iBin=iLogsize; iBin<=LOGMAX && mem5.aiFreelist[iBin]<0; iBin++){}
+  {
+    u32 mask = mem5.freeMask & ~((1u<<iLogsize)-1);
+#if defined(__GNUC__)
+    iBin = mask ? __builtin_ctz(mask) : LOGMAX+1;
+#else
+    for(iBin=iLogsize; iBin<=LOGMAX && (mask & (1u<<iBin))==0; iBin++){}
+#endif
+    assert( iBin>LOGMAX || mem5.aiFreelist[iBin]>=0 );
+  }
   if( iBin>LOGMAX ){
     testcase( sqlite3GlobalConfig.xLog!=0 );
     sqlite3_log(SQLITE_NOMEM, "failed to allocate %u bytes", nByte);
@@ -488,6 +504,10 @@ static int memsys5Init(void *NotUsed){
   mem5.zPool = zByte;
   mem5.aCtrl = (u8 *)&mem5.zPool[mem5.nBlock*mem5.szAtom];
 
+  /* Clear freeMask along with the freelists: on a re-initialization
+  ** (shutdown followed by SQLITE_CONFIG_HEAP and sqlite3_initialize())
+  ** stale bits would send memsys5MallocUnsafe() to an empty list. */
+  mem5.freeMask = 0;
   for(ii=0; ii<=LOGMAX; ii++){
     mem5.aiFreelist[ii] = -1;
   }
@@ -267,6 +267,10 @@ struct unixFile {
   const char *zPath;                  /* Name of the file */
   unixShm *pShm;                      /* Shared memory segment information */
   int szChunk;                        /* Configured by FCNTL_CHUNK_SIZE */
+#if defined(__linux__) && defined(SQLITE_ENABLE_IOURING)
+  struct unixUring *pUring;           /* io_uring state ("unix-uring" VFS) */
+  unsigned char bUringDefer;          /* True to batch writes until xSync */
+#endif
 #if SQLITE_MAX_MMAP_SIZE>0
   int nFetchOut;                      /* Number of outstanding xFetch refs */
   sqlite3_int64 mmapSize;             /* Usable size of mapping at pMapRegion */
@@ -4103,6 +4107,13 @@ static int unixFileControl(sqlite3_file *id, int op, void *pArg){
     }
 #endif /* SQLITE_ENABLE_LOCKING_STYLE && defined(__APPLE__) */
 
+#if defined(POSIX_FADV_WILLNEED)
+    case SQLITE_FCNTL_PREFETCH: {
+      sqlite3_int64 *a = (sqlite3_int64*)pArg;
+      posix_fadvise(pFile->h, (off_t)a[0], (off_t)a[1], POSIX_FADV_WILLNEED);
+      return SQLITE_OK;
+    }
+#endif
     case SQLITE_FCNTL_EXTERNAL_READER: {
 #ifndef SQLITE_OMIT_SHARED_MEM
       return unixFcntlExternalReader((unixFile*)id, (int*)pArg);
@@ -4862,7 +4873,15 @@ static int unixShmMap(
       if( pShmNode->hShm>=0 ){
         pMem = osMmap(0, nMap,
             pShmNode->isReadonly ? PROT_READ : PROT_READ|PROT_WRITE,
-            MAP_SHARED, pShmNode->hShm, szRegion*(i64)pShmNode->nRegion
+            MAP_SHARED
+#if defined(MAP_POPULATE)
+            /* Prefault the wal-index region: it will be touched
+            ** immediately (header then hash tables), and taking the
+            ** faults here, once per region, beats taking them inside
+            ** reader-mark scans on long WALs. */
+            | MAP_POPULATE
+#endif
+            , pShmNode->hShm, szRegion*(i64)pShmNode->nRegion
         );
         if( pMem==MAP_FAILED ){
           rc = unixLogError(SQLITE_IOERR_SHMMAP, "mmap", pShmNode->zFilename);
@@ -5362,6 +5381,380 @@ static int unixUnfetch(sqlite3_file *fd, i64 iOff, void *p){
   return SQLITE_OK;
 }
 
+/*
+** The division below implements the "unix-uring" VFS, which batches
+** write syscalls through a Linux io_uring submission queue.  Writes to
+** WAL files are queued in the ring and only submitted (in a single
+** io_uring_enter() call) when the file is synced, read, truncated,
+** sized or explicitly drained - so a commit of N frames costs one ring
+** submission plus one fdatasync instead of N pwrite64 calls plus one
+** fdatasync.
+**
+** Coherence rules.  Queued bytes exist only in this connection's ring,
+** so nothing may make them observable to another descriptor first:
+** walFrames() sends SQLITE_FCNTL_WRITE_DRAIN before publishing a
+** commit in the wal-index header (covering synchronous=NORMAL, where
+** no commit-time xSync arrives), and a write overlapping a queued one
+** forces a drain before being queued, because completions within one
+** submission batch are unordered and the stale image could land last.
+**
+** Writes to files other than WAL files take the ordinary unixWrite()
+** path.  This is deliberate: during a checkpoint the caller reuses a
+** single copy buffer between consecutive xWrite() calls on the database
+** file, so those writes cannot be left pending.  Writes of 64 bytes or
+** less (WAL frame and file headers, which the WAL layer builds in stack
+** buffers) are copied into ring-owned storage before being queued.
+**
+** If io_uring_setup() fails - kernel too old, RLIMIT_MEMLOCK, seccomp -
+** the file permanently falls back to the standard unixFile read/write
+** path.  Only available when compiled with SQLITE_ENABLE_IOURING.
+*/
+#if defined(__linux__) && defined(SQLITE_ENABLE_IOURING)
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+
+/* Number of submission queue entries.  Must be a power of two.  Also the
+** bound on writes left pending between two xSync() calls. */
+#define URING_QUEUE_DEPTH   64
+
+/* Writes of this many bytes or fewer are copied into unixUring.aHdrSpace
+** before being queued, because the caller's buffer may live on the stack. */
+#define URING_HDRCOPY_SZ    64
+
+/*
+** State for one io_uring attached to a unixFile.  The ring is created
+** lazily on the first deferrable write and torn down by uringClose().
+*/
+typedef struct unixUring unixUring;
+struct unixUring {
+  int ringFd;                     /* Ring file descriptor */
+  unsigned nQueued;               /* SQEs filled but not yet submitted */
+  unsigned nInFlight;             /* SQEs submitted but not yet reaped */
+  int iErr;                       /* Sticky error reported at next drain */
+  unsigned sqMask;                /* Submission queue size - 1 */
+  unsigned cqMask;                /* Completion queue size - 1 */
+  unsigned *pSqHead;              /* Kernel's SQ consumer index */
+  unsigned *pSqTail;              /* Our SQ producer index */
+  unsigned *pCqHead;              /* Our CQ consumer index */
+  unsigned *pCqTail;              /* Kernel's CQ producer index */
+  unsigned *aSqArray;             /* SQ index array */
+  struct io_uring_sqe *aSqe;      /* Submission queue entries */
+  struct io_uring_cqe *aCqe;      /* Completion queue entries */
+  void *pSqRing;                  /* SQ ring mapping */
+  void *pCqRing;                  /* CQ ring mapping (==pSqRing if shared) */
+  size_t szSqRing;                /* Size of SQ ring mapping */
+  size_t szCqRing;                /* Size of CQ ring mapping */
+  size_t szSqe;                   /* Size of SQE array mapping */
+  /* Copies of small (header) writes, indexed by SQ slot */
+  unsigned char aHdrSpace[URING_QUEUE_DEPTH][URING_HDRCOPY_SZ];
+};
+
+/* The io_uring syscalls are invoked directly rather than through the
+** aSyscall[] table: they are Linux-only, optional, and have no business
+** being overridden by the fault-injection layer, which already covers the
+** pread/pwrite fallback path. */
+static int uringSetup(unsigned nEntries, struct io_uring_params *p){
+  return (int)syscall(__NR_io_uring_setup, nEntries, p);
+}
+static int uringEnter(int fd, unsigned nSubmit, unsigned nComplete, unsigned flags){
+  return (int)syscall(__NR_io_uring_enter, fd, nSubmit, nComplete, flags, 0, 0);
+}
+
+/*
+** Tear down the ring attached to pFd, if any.  Any queued-but-unsubmitted
+** writes are dropped, so this must only be called after uringDrain() (or
+** when dropping the file anyway because xClose is about to fail).
+*/
+static void uringTeardown(unixFile *pFd){
+  unixUring *p = pFd->pUring;
+  if( p ){
+    if( p->nInFlight>0 ){
+      /* A failed drain left writes in flight that still reference the
+      ** mappings and aHdrSpace[].  Closing the ring fd lets the kernel
+      ** finish or cancel them in its own time; the struct and mappings
+      ** are deliberately leaked rather than handed back to the allocator
+      ** while the kernel may still read them. */
+      if( p->ringFd>=0 ) robust_close(pFd, p->ringFd, __LINE__);
+      pFd->pUring = 0;
+      return;
+    }
+    if( p->aSqe ) osMunmap(p->aSqe, p->szSqe);
+    if( p->pCqRing && p->pCqRing!=p->pSqRing ) osMunmap(p->pCqRing, p->szCqRing);
+    if( p->pSqRing ) osMunmap(p->pSqRing, p->szSqRing);
+    if( p->ringFd>=0 ) robust_close(pFd, p->ringFd, __LINE__);
+    sqlite3_free(p);
+    pFd->pUring = 0;
+  }
+}
+
+/*
+** Create the io_uring for pFd.  On any failure the file is marked so that
+** all subsequent I/O uses the ordinary unixFile path, and SQLITE_OK is
+** still returned - inability to set up a ring is a fallback, not an error.
+*/
+static int uringInit(unixFile *pFd){
+  struct io_uring_params params;
+  unixUring *p;
+  int fd;
+
+  assert( pFd->pUring==0 );
+  p = sqlite3_malloc64( sizeof(unixUring) );
+  if( p==0 ) return SQLITE_NOMEM_BKPT;
+  memset(p, 0, sizeof(unixUring));
+  memset(&params, 0, sizeof(params));
+  fd = uringSetup(URING_QUEUE_DEPTH, &params);
+  if( fd<0 ){
+    sqlite3_free(p);
+    pFd->bUringDefer = 0;       /* Permanent fallback to unixWrite() */
+    return SQLITE_OK;
+  }
+  p->ringFd = fd;
+  p->szSqRing = params.sq_off.array + params.sq_entries*sizeof(unsigned);
+  p->szCqRing = params.cq_off.cqes + params.cq_entries*sizeof(struct io_uring_cqe);
+  if( params.features & IORING_FEAT_SINGLE_MMAP ){
+    if( p->szCqRing>p->szSqRing ) p->szSqRing = p->szCqRing;
+    p->szCqRing = p->szSqRing;
+  }
+  p->pSqRing = osMmap(0, p->szSqRing, PROT_READ|PROT_WRITE,
+                      MAP_SHARED|MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if( p->pSqRing==MAP_FAILED ) goto init_failed;
+  if( params.features & IORING_FEAT_SINGLE_MMAP ){
+    p->pCqRing = p->pSqRing;
+  }else{
+    p->pCqRing = osMmap(0, p->szCqRing, PROT_READ|PROT_WRITE,
+                        MAP_SHARED|MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if( p->pCqRing==MAP_FAILED ){ p->pCqRing = 0; goto init_failed; }
+  }
+  p->szSqe = params.sq_entries*sizeof(struct io_uring_sqe);
+  p->aSqe = osMmap(0, p->szSqe, PROT_READ|PROT_WRITE,
+                   MAP_SHARED|MAP_POPULATE, fd, IORING_OFF_SQES);
+  if( p->aSqe==MAP_FAILED ){ p->aSqe = 0; goto init_failed; }
+  p->pSqHead = (unsigned*)((char*)p->pSqRing + params.sq_off.head);
+  p->pSqTail = (unsigned*)((char*)p->pSqRing + params.sq_off.tail);
+  p->sqMask = *(unsigned*)((char*)p->pSqRing + params.sq_off.ring_mask);
+  p->aSqArray = (unsigned*)((char*)p->pSqRing + params.sq_off.array);
+  p->pCqHead = (unsigned*)((char*)p->pCqRing + params.cq_off.head);
+  p->pCqTail = (unsigned*)((char*)p->pCqRing + params.cq_off.tail);
+  p->cqMask = *(unsigned*)((char*)p->pCqRing + params.cq_off.ring_mask);
+  p->aCqe = (struct io_uring_cqe*)((char*)p->pCqRing + params.cq_off.cqes);
+  pFd->pUring = p;
+  return SQLITE_OK;
+
+init_failed:
+  pFd->pUring = p;              /* So that uringTeardown() can unwind */
+  uringTeardown(pFd);
+  pFd->bUringDefer = 0;
+  return SQLITE_OK;
+}
+
+/*
+** Harvest all available completion queue entries.  A negative res or a
+** short write latches an error in unixUring.iErr; it is reported to the
+** caller by the next uringDrain().
+*/
+static void uringReap(unixFile *pFd){
+  unixUring *p = pFd->pUring;
+  unsigned head = __atomic_load_n(p->pCqHead, __ATOMIC_ACQUIRE);
+  unsigned tail = __atomic_load_n(p->pCqTail, __ATOMIC_ACQUIRE);
+  while( head!=tail ){
+    struct io_uring_cqe *pCqe = &p->aCqe[head & p->cqMask];
+    if( pCqe->res!=(int)pCqe->user_data && p->iErr==SQLITE_OK ){
+      if( pCqe->res==-ENOSPC || pCqe->res>=0 ){
+        p->iErr = SQLITE_FULL;
+        storeLastErrno(pFd, ENOSPC);
+      }else{
+        p->iErr = SQLITE_IOERR_WRITE;
+        storeLastErrno(pFd, -pCqe->res);
+      }
+    }
+    head++;
+    assert( p->nInFlight>0 );
+    p->nInFlight--;
+  }
+  __atomic_store_n(p->pCqHead, head, __ATOMIC_RELEASE);
+}
+
+/*
+** Submit all queued SQEs and wait until every in-flight write has
+** completed.  Returns the sticky error latched by uringReap(), if any,
+** and clears it - exactly like the deferred error reporting that the OS
+** page cache gives buffered writes at fsync() time.
+*/
+static int uringDrain(unixFile *pFd){
+  unixUring *p = pFd->pUring;
+  int rc;
+  if( p==0 ) return SQLITE_OK;
+  while( p->nQueued>0 || p->nInFlight>0 ){
+    int n = uringEnter(p->ringFd, p->nQueued, p->nQueued+p->nInFlight,
+                       IORING_ENTER_GETEVENTS);
+    if( n<0 ){
+      if( errno==EINTR ) continue;
+      storeLastErrno(pFd, errno);
+      if( p->iErr==SQLITE_OK ) p->iErr = SQLITE_IOERR_WRITE;
+      break;
+    }
+    p->nInFlight += n;
+    p->nQueued -= n;
+    uringReap(pFd);
+  }
+  rc = p->iErr;
+  p->iErr = SQLITE_OK;
+  return rc;
+}
+
+/*
+** Queue one write in the submission queue without submitting it.  The
+** caller has verified that there is a free SQ slot.
+*/
+static void uringEnqueueWrite(
+  unixFile *pFd,                  /* File to write to */
+  const void *pBuf,               /* Data to be written */
+  int amt,                        /* Number of bytes to write */
+  sqlite3_int64 offset            /* File offset to write to */
+){
+  unixUring *p = pFd->pUring;
+  unsigned tail = *p->pSqTail;
+  unsigned idx = tail & p->sqMask;
+  struct io_uring_sqe *pSqe = &p->aSqe[idx];
+
+  if( amt<=URING_HDRCOPY_SZ ){
+    memcpy(p->aHdrSpace[idx], pBuf, amt);
+    pBuf = p->aHdrSpace[idx];
+  }
+  memset(pSqe, 0, sizeof(*pSqe));
+  pSqe->opcode = IORING_OP_WRITE;
+  pSqe->fd = pFd->h;
+  pSqe->addr = (unsigned long long)(uptr)pBuf;
+  pSqe->len = (unsigned)amt;
+  pSqe->off = (unsigned long long)offset;
+  pSqe->user_data = (unsigned long long)amt;  /* Expected res, for reap */
+  p->aSqArray[idx] = idx;
+  __atomic_store_n(p->pSqTail, tail+1, __ATOMIC_RELEASE);
+  p->nQueued++;
+}
+
+/* Forward references to the standard unixFile methods wrapped below */
+static int unixRead(sqlite3_file*, void*, int, sqlite3_int64);
+static int unixWrite(sqlite3_file*, const void*, int, sqlite3_int64);
+static const sqlite3_io_methods uringNolockIoMethods;
+
+/*
+** Write data to a "unix-uring" file.  WAL writes are queued in the ring;
+** everything else goes through unixWrite() directly.
+*/
+static int uringWrite(
+  sqlite3_file *id,
+  const void *pBuf,
+  int amt,
+  sqlite3_int64 offset
+){
+  unixFile *pFile = (unixFile*)id;
+  unixUring *p;
+  if( !pFile->bUringDefer ) return unixWrite(id, pBuf, amt, offset);
+  if( pFile->pUring==0 ){
+    int rc = uringInit(pFile);
+    if( rc ) return rc;
+    if( pFile->pUring==0 ) return unixWrite(id, pBuf, amt, offset);
+  }
+  p = pFile->pUring;
+  if( p->nQueued+p->nInFlight>=URING_QUEUE_DEPTH ){
+    int rc = uringDrain(pFile);
+    if( rc ) return rc;
+  }
+
+  /* Two writes covering the same bytes (a cache spill followed by the
+  ** frame-overwrite path rewriting the frame) must not go into one
+  ** submission batch: IORING_OP_WRITE completions carry no ordering, so
+  ** the stale image could land last.  Drain first so the older write is
+  ** on disk before the newer one is queued. */
+  if( p->nQueued>0 ){
+    unsigned tail = *p->pSqTail;
+    unsigned j;
+    for(j=tail-p->nQueued; j!=tail; j++){
+      struct io_uring_sqe *pOld = &p->aSqe[j & p->sqMask];
+      if( (sqlite3_int64)pOld->off < offset+amt
+       && offset < (sqlite3_int64)(pOld->off+pOld->len) ){
+        int rc = uringDrain(pFile);
+        if( rc ) return rc;
+        break;
+      }
+    }
+  }
+  uringEnqueueWrite(pFile, pBuf, amt, offset);
+  return SQLITE_OK;
+}
+
+/*
+** Read from a "unix-uring" file.  Pending writes are forced to stable
+** ordering first so that the read observes them.
+*/
+static int uringRead(
+  sqlite3_file *id,
+  void *pBuf,
+  int amt,
+  sqlite3_int64 offset
+){
+  int rc = uringDrain((unixFile*)id);
+  if( rc ) return rc;
+  return unixRead(id, pBuf, amt, offset);
+}
+
+/*
+** File control for a "unix-uring" file.  SQLITE_FCNTL_WRITE_DRAIN
+** submits and completes every deferred write - walFrames() sends it
+** before publishing a commit in the wal-index header, so that no reader
+** can learn of frames whose bytes are still queued in this connection's
+** private ring.  Everything else takes the standard path.
+*/
+static int uringFileControl(sqlite3_file *id, int op, void *pArg){
+  if( op==SQLITE_FCNTL_WRITE_DRAIN ){
+    return uringDrain((unixFile*)id);
+  }
+  return unixFileControl(id, op, pArg);
+}
+
+/* Sync a "unix-uring" file: one ring submission covering every queued
+** write, then the ordinary unixSync() fsync/fdatasync logic. */
+static int uringSync(sqlite3_file *id, int flags){
+  int rc = uringDrain((unixFile*)id);
+  if( rc ) return rc;
+  return unixSync(id, flags);
+}
+
+/* Truncate a "unix-uring" file */
+static int uringTruncate(sqlite3_file *id, i64 nByte){
+  int rc = uringDrain((unixFile*)id);
+  if( rc ) return rc;
+  return unixTruncate(id, nByte);
+}
+
+/* Determine the size of a "unix-uring" file in bytes */
+static int uringFileSize(sqlite3_file *id, i64 *pSize){
+  int rc = uringDrain((unixFile*)id);
+  if( rc ) return rc;
+  return unixFileSize(id, pSize);
+}
+
+/* Close a "unix-uring" file.  WAL files carry the nolock variant of
+** the method table and must take nolockClose() - unixClose() asserts
+** on (and dereferences) the pInode that nolock files never acquire. */
+static int uringClose(sqlite3_file *id){
+  unixFile *pFile = (unixFile*)id;
+  int rc = uringDrain(pFile);
+  int rc2;
+  uringTeardown(pFile);
+  if( pFile->pMethod==&uringNolockIoMethods ){
+    rc2 = nolockClose(id);
+  }else{
+    rc2 = unixClose(id);
+  }
+  return rc ? rc : rc2;
+}
+
+#endif /* defined(__linux__) && defined(SQLITE_ENABLE_IOURING) */
+/************** End of the io_uring division *********************************/
+
 /*
 ** Here ends the implementation of all sqlite3_file methods.
 **
@@ -5467,6 +5860,69 @@ IOMETHODS(
   0                         /* xShmMap method */
 )
 
+#if defined(__linux__) && defined(SQLITE_ENABLE_IOURING)
+/*
+** The I/O methods for "unix-uring" files.  This object cannot be built
+** with the IOMETHODS macro because that macro hard-wires unixRead and
+** unixWrite.  POSIX advisory locking is used, as for "unix" itself.
+*/
+static const sqlite3_io_methods uringIoMethods = {
+   3,                          /* iVersion */
+   uringClose,                 /* xClose */
+   uringRead,                  /* xRead */
+   uringWrite,                 /* xWrite */
+   uringTruncate,              /* xTruncate */
+   uringSync,                  /* xSync */
+   uringFileSize,              /* xFileSize */
+   unixLock,                   /* xLock */
+   unixUnlock,                 /* xUnlock */
+   unixCheckReservedLock,      /* xCheckReservedLock */
+   uringFileControl,           /* xFileControl */
+   unixSectorSize,             /* xSectorSize */
+   unixDeviceCharacteristics,  /* xDeviceCapabilities */
+   unixShmMap,                 /* xShmMap */
+   unixShmLock,                /* xShmLock */
+   unixShmBarrier,             /* xShmBarrier */
+   unixShmUnmap,               /* xShmUnmap */
+   unixFetch,                  /* xFetch */
+   unixUnfetch,                /* xUnfetch */
+};
+/*
+** Variant of the above for the files that actually defer writes: WAL
+** files are opened with UNIXFILE_NOLOCK (their locking goes through the
+** shm region of the database file), so they never reach the finder and
+** need their own nolock method table or the ring would sit unused.
+*/
+static const sqlite3_io_methods uringNolockIoMethods = {
+   3,                          /* iVersion */
+   uringClose,                 /* xClose */
+   uringRead,                  /* xRead */
+   uringWrite,                 /* xWrite */
+   uringTruncate,              /* xTruncate */
+   uringSync,                  /* xSync */
+   uringFileSize,              /* xFileSize */
+   nolockLock,                 /* xLock */
+   nolockUnlock,               /* xUnlock */
+   nolockCheckReservedLock,    /* xCheckReservedLock */
+   uringFileControl,           /* xFileControl */
+   unixSectorSize,             /* xSectorSize */
+   unixDeviceCharacteristics,  /* xDeviceCapabilities */
+   unixShmMap,                 /* xShmMap */
+   unixShmLock,                /* xShmLock */
+   unixShmBarrier,             /* xShmBarrier */
+   unixShmUnmap,               /* xShmUnmap */
+   unixFetch,                  /* xFetch */
+   unixUnfetch,                /* xUnfetch */
+};
+
+static const sqlite3_io_methods *uringIoFinderImpl(const char *z, unixFile *p){
+  UNUSED_PARAMETER(z); UNUSED_PARAMETER(p);
+  return &uringIoMethods;
+}
+static const sqlite3_io_methods *(*const uringIoFinder)(const char*,unixFile *p)
+    = uringIoFinderImpl;
+#endif /* defined(__linux__) && defined(SQLITE_ENABLE_IOURING) */
+
 #if SQLITE_ENABLE_LOCKING_STYLE
 IOMETHODS(
   flockIoFinder,            /* Finder function name */
@@ -5706,6 +6162,15 @@ static int fillInUnixFile(
 
   if( ctrlFlags & UNIXFILE_NOLOCK ){
     pLockingStyle = &nolockIoMethods;
+#if defined(__linux__) && defined(SQLITE_ENABLE_IOURING)
+    if( pNew->bUringDefer ){
+      if( strcmp(pVfs->zName,"unix-uring")==0 ){
+        pLockingStyle = &uringNolockIoMethods;
+      }else{
+        pNew->bUringDefer = 0;
+      }
+    }
+#endif
   }else{
     pLockingStyle = (**(finder_type*)pVfs->pAppData)(zFilename, pNew);
 #if SQLITE_ENABLE_LOCKING_STYLE
@@ -5717,6 +6182,9 @@ static int fillInUnixFile(
   }
 
   if( pLockingStyle == &posixIoMethods
+#if defined(__linux__) && defined(SQLITE_ENABLE_IOURING)
+    || pLockingStyle == &uringIoMethods
+#endif
 #if defined(__APPLE__) && SQLITE_ENABLE_LOCKING_STYLE
     || pLockingStyle == &nfsIoMethods
 #endif
@@ -6191,6 +6659,11 @@ static int unixOpen(
     sqlite3_randomness(0,0);
   }
   memset(p, 0, sizeof(unixFile));
+#if defined(__linux__) && defined(SQLITE_ENABLE_IOURING)
+  /* Only WAL writes may be left pending in the ring; see the io_uring
+  ** division for why database and journal writes may not. */
+  p->bUringDefer = (eType==SQLITE_OPEN_WAL);
+#endif
 
 #ifdef SQLITE_ASSERT_NO_FILES
   /* Applications that never read or write a persistent disk files */
@@ -6218,8 +6691,30 @@ static int unixOpen(
   }else if( !zName ){
     /* If zName is NULL, the upper layer is requesting a temp file. */
     assert(isDelete && !isNewJrnl);
+#if defined(O_TMPFILE) && !OS_VXWORKS && !defined(SQLITE_UNLINK_AFTER_CLOSE)
+    /* Prefer an anonymous O_TMPFILE: the file never appears in the
+    ** directory, so there is no name-generation race, no unlink
+    ** syscall, and nothing to leak if the process dies between open
+    ** and unlink.  Fall through to the named-then-unlinked scheme on
+    ** filesystems (or kernels) that do not support it. */
+    {
+      const char *zDir;
+      sqlite3_mutex_enter(sqlite3MutexAlloc(SQLITE_MUTEX_STATIC_TEMPDIR));
+      zDir = unixTempFileDir();
+      if( zDir!=0 ){
+        int fdTmp = robust_open(zDir, O_TMPFILE|O_RDWR|O_LARGEFILE|O_BINARY,
+                                SQLITE_DEFAULT_FILE_PERMISSIONS);
+        if( fdTmp>=0 ){
+          fd = fdTmp;
+          isDelete = 0;   /* Nothing on disk to unlink */
+        }
+      }
+      sqlite3_mutex_leave(sqlite3MutexAlloc(SQLITE_MUTEX_STATIC_TEMPDIR));
+    }
+#endif
     rc = unixGetTempname(pVfs->mxPathname, zTmpname);
     if( rc!=SQLITE_OK ){
+      if( fd>=0 ) robust_close(p, fd, __LINE__);
       return rc;
     }
     zName = zTmpname;
@@ -8070,6 +8565,9 @@ int sqlite3_os_init(void){
     UNIXVFS("unix-none",     nolockIoFinder ),
     UNIXVFS("unix-dotfile",  dotlockIoFinder ),
     UNIXVFS("unix-excl",     posixIoFinder ),
+#if defined(__linux__) && defined(SQLITE_ENABLE_IOURING)
+    UNIXVFS("unix-uring",    uringIoFinder ),
+#endif
 #if OS_VXWORKS
     UNIXVFS("unix-namedsem", semIoFinder ),
 #endif
@@ -625,6 +625,12 @@ struct Pager {
   u8 extraSync;               /* sync directory after journal delete */
   u8 syncFlags;               /* SYNC_NORMAL or SYNC_FULL otherwise */
   u8 walSyncFlags;            /* See description above */
+  u8 bConcurrent;             /* PRAGMA concurrent_writes=ON */
+#if SQLITE_MAX_MMAP_SIZE>0
+  Pgno pgnoFrameHint;         /* Page for which iFrameHint is valid, or 0 */
+  u32 iFrameHint;             /* WAL frame located by getPageMMap() */
+#endif
+  char *pCombine;             /* Write-combining buffer, allocated lazily */
   u8 tempFile;                /* zFilename is a temporary or immutable file */
   u8 noLock;                  /* Do not lock (except in WAL mode) */
   u8 readOnly;                /* True for a read-only database */
@@ -687,7 +693,8 @@ struct Pager {
   char *zJournal;             /* Name of the journal file */
   int (*xBusyHandler)(void*); /* Function to call when busy */
   void *pBusyHandlerArg;      /* Context argument for xBusyHandler */
-  int aStat[4];               /* Total cache hits, misses, writes, spills */
+  int aStat[6];               /* Cache hits, misses, writes, spills, pages
+                              ** read from the WAL, and fsync calls */
 #ifdef SQLITE_TEST
   int nRead;                  /* Database pages read */
 #endif
@@ -740,10 +747,12 @@ int libsql_pager_codec(libsql_pghdr *hdr, void **ret) {
 ** the values accessed by passing SQLITE_DBSTATUS_CACHE_HIT, CACHE_MISS
 ** or CACHE_WRITE to sqlite3_db_status().
 */
-#define PAGER_STAT_HIT   0
-#define PAGER_STAT_MISS  1
-#define PAGER_STAT_WRITE 2
-#define PAGER_STAT_SPILL 3
+#define PAGER_STAT_HIT     0
+#define PAGER_STAT_MISS    1
+#define PAGER_STAT_WRITE   2
+#define PAGER_STAT_SPILL   3
+#define PAGER_STAT_WALREAD 4
+#define PAGER_STAT_SYNC    5
 
 /*
 ** The following global variables hold counters used for
@@ -3061,11 +3070,21 @@ static int readDbPage(PgHdr *pPg){
   assert( isOpen(pPager->fd) );
 
   if( pagerUseWal(pPager) ){
-    rc = pPager->wal->methods.xFindFrame(pPager->wal->pData, pPg->pgno, &iFrame);
-    if( rc ) return rc;
+#if SQLITE_MAX_MMAP_SIZE>0
+    if( pPager->pgnoFrameHint==pPg->pgno ){
+      /* getPageMMap() already located the frame for this page */
+      iFrame = pPager->iFrameHint;
+      pPager->pgnoFrameHint = 0;
+    }else
+#endif
+    {
+      rc = pPager->wal->methods.xFindFrame(pPager->wal->pData, pPg->pgno, &iFrame);
+      if( rc ) return rc;
+    }
   }
   if( iFrame ){
     rc = pPager->wal->methods.xReadFrame(pPager->wal->pData, iFrame,pPager->pageSize,pPg->pData);
+    pPager->aStat[PAGER_STAT_WALREAD]++;
   }else
 #endif
   {
@@ -3220,6 +3239,15 @@ static int pagerWalFrames(
 
   assert( pagerUseWal(pPager) );
   assert( pList );
+
+#if SQLITE_MAX_MMAP_SIZE>0
+  /* Appending frames may supersede the frame that getPageMMap() located
+  ** for readDbPage().  A hint that survives unconsumed (because the
+  ** hinted fetch was satisfied from the page cache) must not short-cut
+  ** a later read to the old frame. */
+  pPager->pgnoFrameHint = 0;
+#endif
+
 #ifdef SQLITE_DEBUG
   /* Verify that the page list is in ascending order */
   for(p=pList; p && p->pDirty; p=p->pDirty){
@@ -3673,6 +3701,18 @@ void sqlite3PagerSetFlags(
   if( (pgFlags & PAGER_CKPT_FULLFSYNC) && !pPager->noSync ){
     pPager->walSyncFlags |= (SQLITE_SYNC_FULL<<2);
   }
+  if( (pgFlags & PAGER_GROUP_COMMIT)!=0
+   && WAL_SYNC_FLAGS(pPager->walSyncFlags)!=0
+  ){
+    pPager->walSyncFlags |= WAL_SYNC_GROUPCOMMIT;
+  }
+  pPager->bConcurrent = (pgFlags & PAGER_CONCURRENT)!=0;
+  if( pPager->bConcurrent ){
+    pPager->walSyncFlags |= WAL_SYNC_OPTIMISTIC;
+  }
+  if( pgFlags & PAGER_WAL_COMPRESS ){
+    pPager->walSyncFlags |= WAL_SYNC_COMPRESS;
+  }
   if( pgFlags & PAGER_CACHESPILL ){
     pPager->doNotSpill &= ~SPILLFLAG_OFF;
   }else{
@@ -3829,6 +3869,8 @@ int sqlite3PagerSetPagesize(Pager *pPager, u32 *pPageSize, int nReserve){
     }
     if( rc==SQLITE_OK ){
       sqlite3PageFree(pPager->pTmpSpace);
+      sqlite3_free(pPager->pCombine);
+      pPager->pCombine = 0;
       pPager->pTmpSpace = pNew;
       pPager->dbSize = (Pgno)((nByte+pageSize-1)/pageSize);
       pPager->pageSize = pageSize;
@@ -4248,6 +4290,7 @@ int sqlite3PagerClose(Pager *pPager, sqlite3 *db){
   sqlite3OsClose(pPager->jfd);
   sqlite3OsClose(pPager->fd);
   sqlite3PageFree(pTmp);
+  sqlite3_free(pPager->pCombine);
   sqlite3PcacheClose(pPager->pPCache);
   assert( !pPager->aSavepoint && !pPager->pInJournal );
   assert( !isOpen(pPager->jfd) && !isOpen(pPager->sjfd) );
@@ -4450,6 +4493,9 @@ static int syncJournal(Pager *pPager, int newHdr){
 ** occurs, an IO error code is returned. Or, if the EXCLUSIVE lock cannot
 ** be obtained, SQLITE_BUSY is returned.
 */
+/* Maximum number of adjacent dirty pages combined into one OsWrite() */
+#define PAGER_COMBINE_NPAGE 16
+
 static int pager_write_pagelist(Pager *pPager, PgHdr *pList){
   int rc = SQLITE_OK;                  /* Return code */
 
@@ -4495,38 +4541,82 @@ static int pager_write_pagelist(Pager *pPager, PgHdr *pList){
     if( pgno<=pPager->dbSize && 0==(pList->flags&PGHDR_DONT_WRITE) ){
       i64 offset = (pgno-1)*(i64)pPager->pageSize;   /* Offset to write */
       char *pData;                                   /* Data to write */   
+      PgHdr *pRun;                                   /* Run of adjacent pages */
+      int nRun = 1;                                  /* Pages in the run */
+      int i;
 
       assert( (pList->flags&PGHDR_NEED_SYNC)==0 );
       if( pList->pgno==1 ) pager_write_changecounter(pList);
 
       pData = pList->pData;
 
-      /* Write out the page data. */
-      rc = sqlite3OsWrite(pPager->fd, pData, pPager->pageSize, offset);
-
-      /* If page 1 was just written, update Pager.dbFileVers to match
-      ** the value now stored in the database file. If writing this
-      ** page caused the database file to grow, update dbFileSize.
-      */
-      if( pgno==1 ){
-        memcpy(&pPager->dbFileVers, &pData[24], sizeof(pPager->dbFileVers));
+      /* The dirty list is sorted by page number.  Count how many of the
+      ** following pages continue this run contiguously, so that the run
+      ** can be written with a single OsWrite().  On storage billed per
+      ** I/O operation, and for the kernel elevator, one large write
+      ** beats N page-sized ones; the memcpy into the combining buffer
+      ** is noise by comparison. */
+      for(pRun=pList->pDirty;
+          pRun && nRun<PAGER_COMBINE_NPAGE
+               && pRun->pgno==pgno+(Pgno)nRun
+               && pRun->pgno<=pPager->dbSize
+               && 0==(pRun->flags&PGHDR_DONT_WRITE);
+          pRun=pRun->pDirty){
+        nRun++;
+      }
+      if( nRun>1 ){
+        if( pPager->pCombine==0 && sqlite3GlobalConfig.pPage==0 ){
+          /* Deployments that configure SQLITE_CONFIG_PAGECACHE bound
+          ** the size of their allocations (see memsubsys1-4.5), so do
+          ** not introduce a multi-page buffer there: pages are then
+          ** written one at a time, as before write-combining. */
+          pPager->pCombine = sqlite3Malloc(
+              (sqlite3_int64)PAGER_COMBINE_NPAGE*pPager->pageSize);
+        }
+        if( pPager->pCombine==0 ) nRun = 1;
       }
-      if( pgno>pPager->dbFileSize ){
-        pPager->dbFileSize = pgno;
+      if( nRun>1 ){
+        PgHdr *p = pList;
+        for(i=0; i<nRun; i++){
+          memcpy(&pPager->pCombine[i*pPager->pageSize], p->pData,
+                 pPager->pageSize);
+          p = p->pDirty;
+        }
+        rc = sqlite3OsWrite(pPager->fd, pPager->pCombine,
+                            nRun*pPager->pageSize, offset);
+      }else{
+        /* Write out the page data. */
+        rc = sqlite3OsWrite(pPager->fd, pData, pPager->pageSize, offset);
       }
-      pPager->aStat[PAGER_STAT_WRITE]++;
 
-      /* Update any backup objects copying the contents of this pager. */
-      sqlite3BackupUpdate(pPager->pBackup, pgno, (u8*)pList->pData);
+      /* Per-page bookkeeping for every page of the run.  If page 1 was
+      ** just written, update Pager.dbFileVers to match the value now
+      ** stored in the database file. If writing a page caused the
+      ** database file to grow, update dbFileSize.
+      */
+      for(i=0; i<nRun; i++){
+        if( pList->pgno==1 ){
+          memcpy(&pPager->dbFileVers, &pData[24], sizeof(pPager->dbFileVers));
+        }
+        if( pList->pgno>pPager->dbFileSize ){
+          pPager->dbFileSize = pList->pgno;
+        }
+        pPager->aStat[PAGER_STAT_WRITE]++;
 
-      PAGERTRACE(("STORE %d page %d hash(%08x)\n",
-                   PAGERID(pPager), pgno, pager_pagehash(pList)));
-      IOTRACE(("PGOUT %p %d\n", pPager, pgno));
-      PAGER_INCR(sqlite3_pager_writedb_count);
+        /* Update any backup objects copying the contents of this pager. */
+        sqlite3BackupUpdate(pPager->pBackup, pList->pgno, (u8*)pList->pData);
+
+        PAGERTRACE(("STORE %d page %d hash(%08x)\n",
+                     PAGERID(pPager), pList->pgno, pager_pagehash(pList)));
+        IOTRACE(("PGOUT %p %d\n", pPager, pList->pgno));
+        PAGER_INCR(sqlite3_pager_writedb_count);
+        pager_set_pagehash(pList);
+        if( i<nRun-1 ) pList = pList->pDirty;
+      }
     }else{
       PAGERTRACE(("NOSTORE %d page %d\n", PAGERID(pPager), pgno));
+      pager_set_pagehash(pList);
     }
-    pager_set_pagehash(pList);
     pList = pList->pDirty;
   }
 
@@ -5060,6 +5150,7 @@ act_like_temp_file:
   */
   if( rc!=SQLITE_OK ){
     sqlite3OsClose(pPager->fd);
+    sqlite3_free(pPager->pCombine);
     sqlite3PageFree(pPager->pTmpSpace);
     destroy_wal_manager(pPager->wal_manager);
     sqlite3_free(pPager);
@@ -5281,6 +5372,12 @@ static int hasHotJournal(Pager *pPager, int *pExists){
 int sqlite3PagerSharedLock(Pager *pPager){
   int rc = SQLITE_OK;                /* Return code */
 
+#if SQLITE_MAX_MMAP_SIZE>0
+  /* A frame hint left by getPageMMap() is only meaningful within the
+  ** read transaction that produced it */
+  pPager->pgnoFrameHint = 0;
+#endif
+
   /* This routine is only called from b-tree and only when there are no
   ** outstanding pages. This implies that the pager state should either
   ** be OPEN or READER. READER is only possible if the pager is or was in
@@ -5704,6 +5801,14 @@ static int getPageMMap(
       *ppPage = 0;
       return rc;
     }
+    if( iFrame ){
+      /* The page must come from the WAL, so this request is about to
+      ** fall through to getPageNormal().  Leave the located frame
+      ** behind so that readDbPage() does not repeat the wal-index hash
+      ** search. */
+      pPager->pgnoFrameHint = pgno;
+      pPager->iFrameHint = iFrame;
+    }
 #endif
   }
   if( bMmapOk && iFrame==0 ){
@@ -5752,6 +5857,28 @@ static int getPageError(
 
 /* Dispatch all page fetch requests to the appropriate getter method.
 */
+/*
+** Hint to the VFS that page pgno is likely to be read soon.  Called by
+** the b-tree layer when it detects a sequential leaf scan, so that the
+** operating system can keep the device queue full instead of faulting
+** pages in one at a time.  This is advisory only: errors are ignored,
+** and if the page's current content actually lives in the WAL the hint
+** merely warms the wrong file, which is harmless.
+*/
+/* Return the libsql_wal object of pPager, or NULL if not in WAL mode */
+libsql_wal *sqlite3PagerWal(Pager *pPager){
+  return pagerUseWal(pPager) ? pPager->wal : 0;
+}
+
+void sqlite3PagerPrefetch(Pager *pPager, Pgno pgno){
+  sqlite3_int64 a[2];
+  if( pgno==0 || pgno>pPager->dbSize ) return;
+  if( MEMDB || pPager->tempFile || !isOpen(pPager->fd) ) return;
+  a[0] = (sqlite3_int64)(pgno-1)*pPager->pageSize;
+  a[1] = pPager->pageSize;
+  sqlite3OsFileControlHint(pPager->fd, SQLITE_FCNTL_PREFETCH, a);
+}
+
 int sqlite3PagerGet(
   Pager *pPager,      /* The pager open on the database file */
   Pgno pgno,          /* Page number to fetch */
@@ -5975,8 +6102,24 @@ int sqlite3PagerBegin(Pager *pPager, int exFlag, int subjInMemory){
       ** PAGER_RESERVED state. Otherwise, return an error code to the caller.
       ** The busy-handler is not invoked if another connection already
       ** holds the write-lock. If possible, the upper layer will call it.
+      **
+      ** In concurrent-writes mode the lock is instead deferred until the
+      ** frames are written at commit (or first spill): xFrames acquires
+      ** the WRITER lock then and validates that the snapshot this
+      ** transaction read from is still current, failing the commit with
+      ** SQLITE_BUSY_SNAPSHOT otherwise.  Until that point concurrent
+      ** writers prepare their transactions in parallel.
+      **
+      ** An explicit BEGIN IMMEDIATE or BEGIN EXCLUSIVE (exFlag) is a
+      ** request to reserve the write lock up front, so it overrides the
+      ** deferred acquisition - otherwise such transactions could fail at
+      ** COMMIT with SQLITE_BUSY_SNAPSHOT, which they exist to prevent.
       */
-      rc = pPager->wal->methods.xBeginWriteTransaction(pPager->wal->pData);
+      if( pPager->bConcurrent && !pPager->exclusiveMode && !exFlag ){
+        rc = SQLITE_OK;
+      }else{
+        rc = pPager->wal->methods.xBeginWriteTransaction(pPager->wal->pData);
+      }
 #endif
     }else{
       /* Obtain a RESERVED lock on the database file. If the exFlag parameter
@@ -6431,6 +6574,7 @@ static int pager_incr_changecounter(Pager *pPager, int isDirectMode){
 int sqlite3PagerSync(Pager *pPager, const char *zSuper){
   int rc = SQLITE_OK;
   void *pArg = (void*)zSuper;
+  pPager->aStat[PAGER_STAT_SYNC]++;
   rc = sqlite3OsFileControl(pPager->fd, SQLITE_FCNTL_SYNC, pArg);
   if( rc==SQLITE_NOTFOUND ) rc = SQLITE_OK;
   if( rc==SQLITE_OK && !pPager->noSync ){
@@ -6916,6 +7060,8 @@ void sqlite3PagerCacheStat(Pager *pPager, int eStat, int reset, int *pnVal){
        || eStat==SQLITE_DBSTATUS_CACHE_MISS
        || eStat==SQLITE_DBSTATUS_CACHE_WRITE
        || eStat==SQLITE_DBSTATUS_CACHE_WRITE+1
+       || eStat==SQLITE_DBSTATUS_CACHE_WRITE+2   /* CACHE_READ_WAL */
+       || eStat==SQLITE_DBSTATUS_CACHE_WRITE+3   /* FILE_SYNC */
   );
 
   assert( SQLITE_DBSTATUS_CACHE_HIT+1==SQLITE_DBSTATUS_CACHE_MISS );
@@ -106,6 +106,9 @@ typedef struct libsql_pghdr DbPage;
 #define PAGER_CKPT_FULLFSYNC        0x10  /* PRAGMA checkpoint_fullfsync=ON */
 #define PAGER_CACHESPILL            0x20  /* PRAGMA cache_spill=ON */
 #define PAGER_FLAGS_MASK            0x38  /* All above except SYNCHRONOUS */
+#define PAGER_GROUP_COMMIT          0x40  /* PRAGMA wal_group_commit=ON */
+#define PAGER_CONCURRENT            0x80  /* PRAGMA concurrent_writes=ON */
+#define PAGER_WAL_COMPRESS         0x100  /* PRAGMA wal_compression=ON */
 
 /*
 ** The remainder of this file contains the declarations of the functions
@@ -114,6 +117,7 @@ typedef struct libsql_pghdr DbPage;
 */
 
 typedef struct libsql_wal_methods libsql_wal_methods;
+typedef struct libsql_wal libsql_wal;
 
 /* Open and close a Pager connection. */ 
 int sqlite3PagerOpen(
@@ -148,6 +152,8 @@ int sqlite3PagerFlush(Pager*);
 
 /* Functions used to obtain and release page references. */ 
 int sqlite3PagerGet(Pager *pPager, Pgno pgno, DbPage **ppPage, int clrFlag);
+void sqlite3PagerPrefetch(Pager *pPager, Pgno pgno);
+libsql_wal *sqlite3PagerWal(Pager *pPager);
 DbPage *sqlite3PagerLookup(Pager *pPager, Pgno pgno);
 void sqlite3PagerRef(DbPage*);
 void sqlite3PagerUnref(DbPage*);
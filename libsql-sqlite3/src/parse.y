@@ -1084,12 +1084,17 @@ idlist(A) ::= nm(Y).
 
   /* Construct a new Expr object from a single token */
   static Expr *tokenExpr(Parse *pParse, int op, Token t){
-    Expr *p = sqlite3DbMallocRawNN(pParse->db, sizeof(Expr)+t.n+1);
+    u32 flags = EP_Leaf|EP_Arena;
+    Expr *p = sqlite3ParseArenaAlloc(pParse, sizeof(Expr)+t.n+1);
+    if( p==0 ){
+      p = sqlite3DbMallocRawNN(pParse->db, sizeof(Expr)+t.n+1);
+      flags = EP_Leaf;
+    }
     if( p ){
       /* memset(p, 0, sizeof(Expr)); */
       p->op = (u8)op;
       p->affExpr = 0;
-      p->flags = EP_Leaf;
+      p->flags = flags;
       ExprClearVVAProperties(p);
       /* p->iAgg = -1; // Not required */
       p->pLeft = p->pRight = 0;
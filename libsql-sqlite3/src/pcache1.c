@@ -119,6 +119,10 @@ struct PgHdr1 {
   unsigned int iKey;        /* Key value (page number) */
   u16 isBulkLocal;          /* This page from bulk local storage */
   u16 isAnchor;             /* This is the PGroup.lru element */
+#ifdef SQLITE_ENABLE_CLOCK_PCACHE
+  u16 isPinned;             /* Pinned but still on the LRU list (clock mode) */
+  u16 bClkRef;              /* Referenced since the last eviction scan */
+#endif
   PgHdr1 *pNext;            /* Next in hash table chain */
   PCache1 *pCache;          /* Cache that currently owns this page */
   PgHdr1 *pLruNext;         /* Next in circular LRU list of unpinned pages */
@@ -130,8 +134,12 @@ struct PgHdr1 {
 ** A page is pinned if it is not on the LRU list.  To be "pinned" means
 ** that the page is in active use and must not be deallocated.
 */
-#define PAGE_IS_PINNED(p)    ((p)->pLruNext==0)
-#define PAGE_IS_UNPINNED(p)  ((p)->pLruNext!=0)
+#ifdef SQLITE_ENABLE_CLOCK_PCACHE
+# define PAGE_IS_PINNED(p)   ((p)->pLruNext==0 || (p)->isPinned)
+#else
+# define PAGE_IS_PINNED(p)   ((p)->pLruNext==0)
+#endif
+#define PAGE_IS_UNPINNED(p)  (!PAGE_IS_PINNED(p))
 
 /* Each page cache (or PCache) belongs to a PGroup.  A PGroup is a set
 ** of one or more PCaches that are able to recycle each other's unpinned
@@ -200,6 +208,8 @@ struct PCache1 {
   PgHdr1 **apHash;                    /* Hash table for fast lookup by key */
   PgHdr1 *pFree;                      /* List of unused pcache-local pages */
   void *pBulk;                        /* Bulk memory used by pcache-local */
+  char *zBulkNext;                    /* Next uncarved slot in pBulk */
+  int nBulkFree;                      /* Uncarved slots remaining in pBulk */
 };
 
 /*
@@ -316,20 +326,39 @@ static int pcache1InitBulk(PCache1 *pCache){
   zBulk = pCache->pBulk = sqlite3Malloc( szBulk );
   sqlite3EndBenignMalloc();
   if( zBulk ){
-    int nBulk = sqlite3MallocSize(zBulk)/pCache->szAlloc;
-    do{
-      PgHdr1 *pX = (PgHdr1*)&zBulk[pCache->szPage];
-      pX->page.pBuf = zBulk;
-      pX->page.pExtra = &pX[1];
-      pX->isBulkLocal = 1;
-      pX->isAnchor = 0;
-      pX->pNext = pCache->pFree;
-      pX->pLruPrev = 0;           /* Initializing this saves a valgrind error */
-      pCache->pFree = pX;
-      zBulk += pCache->szAlloc;
-    }while( --nBulk );
+    /* Slots are carved out of the bulk allocation lazily, one at a time
+    ** as pages are needed, instead of being initialized and linked into
+    ** the free list here.  On NUMA systems with first-touch placement
+    ** this matters: the thread that faults a page's memory determines
+    ** which node backs it, and pages should be backed by the node of
+    ** the thread that actually uses the cache - often not the thread
+    ** that opened the connection. */
+    pCache->zBulkNext = zBulk;
+    pCache->nBulkFree = sqlite3MallocSize(zBulk)/pCache->szAlloc;
   }
-  return pCache->pFree!=0;
+  return pCache->nBulkFree>0;
+}
+
+/*
+** Carve the next page out of the cache's bulk allocation, or return
+** NULL if the bulk allocation is exhausted.  See pcache1InitBulk() for
+** why slots are carved on demand.
+*/
+static PgHdr1 *pcache1BulkCarve(PCache1 *pCache){
+  char *zBulk;
+  PgHdr1 *pX;
+  if( pCache->nBulkFree<=0 ) return 0;
+  zBulk = pCache->zBulkNext;
+  pCache->zBulkNext += pCache->szAlloc;
+  pCache->nBulkFree--;
+  pX = (PgHdr1*)&zBulk[pCache->szPage];
+  pX->page.pBuf = zBulk;
+  pX->page.pExtra = &pX[1];
+  pX->isBulkLocal = 1;
+  pX->isAnchor = 0;
+  pX->pNext = 0;
+  pX->pLruPrev = 0;             /* Initializing this saves a valgrind error */
+  return pX;
 }
 
 /*
@@ -434,11 +463,18 @@ static PgHdr1 *pcache1AllocPage(PCache1 *pCache, int benignMalloc){
   void *pPg;
 
   assert( sqlite3_mutex_held(pCache->pGroup->mutex) );
-  if( pCache->pFree || (pCache->nPage==0 && pcache1InitBulk(pCache)) ){
-    assert( pCache->pFree!=0 );
-    p = pCache->pFree;
-    pCache->pFree = p->pNext;
-    p->pNext = 0;
+  if( pCache->pFree
+   || pCache->nBulkFree>0
+   || (pCache->nPage==0 && pcache1InitBulk(pCache))
+  ){
+    if( pCache->pFree ){
+      p = pCache->pFree;
+      pCache->pFree = p->pNext;
+      p->pNext = 0;
+    }else{
+      p = pcache1BulkCarve(pCache);
+      assert( p!=0 );
+    }
   }else{
 #ifdef SQLITE_ENABLE_MEMORY_MANAGEMENT
     /* The group mutex must be released before pcache1Alloc() is called. This
@@ -577,7 +613,6 @@ static void pcache1ResizeHash(PCache1 *p){
 */
 static PgHdr1 *pcache1PinPage(PgHdr1 *pPage){
   assert( pPage!=0 );
-  assert( PAGE_IS_UNPINNED(pPage) );
   assert( pPage->pLruNext );
   assert( pPage->pLruPrev );
   assert( sqlite3_mutex_held(pPage->pCache->pGroup->mutex) );
@@ -588,10 +623,57 @@ static PgHdr1 *pcache1PinPage(PgHdr1 *pPage){
   ** No need to clear pLruPrev as it is never accessed if pLruNext is 0 */
   assert( pPage->isAnchor==0 );
   assert( pPage->pCache->pGroup->lru.isAnchor==1 );
+#ifdef SQLITE_ENABLE_CLOCK_PCACHE
+  if( pPage->isPinned ){
+    /* The page was clock-pinned in place; nRecyclable was decremented
+    ** at that time. */
+    pPage->isPinned = 0;
+  }else{
+    pPage->pCache->nRecyclable--;
+  }
+#else
   pPage->pCache->nRecyclable--;
+#endif
   return pPage;
 }
 
+#ifdef SQLITE_ENABLE_CLOCK_PCACHE
+/* Maximum number of LRU entries examined by one eviction scan */
+#define PCACHE1_CLOCK_MAX_SCAN 32
+
+/*
+** Select a page to evict using a CLOCK (second-chance) scan from the
+** cold end of the LRU list.  Pages that were fetched since the last
+** scan have their reference bit cleared and are rotated back to the hot
+** end instead of being evicted; pages pinned in place are skipped.
+** Returns NULL if no victim was found within the scan bound, in which
+** case the caller allocates a fresh page instead.
+**
+** The PGroup mutex must be held when this function is called.
+*/
+static PgHdr1 *pcache1ClockVictim(PGroup *pGroup){
+  PgHdr1 *p = pGroup->lru.pLruPrev;
+  int nScan;
+  assert( sqlite3_mutex_held(pGroup->mutex) );
+  for(nScan=0; p->isAnchor==0 && nScan<PCACHE1_CLOCK_MAX_SCAN; nScan++){
+    PgHdr1 *pPrev = p->pLruPrev;
+    if( p->isPinned==0 ){
+      if( p->bClkRef==0 ) return p;
+      /* Second chance: clear the reference bit and rotate to the front */
+      p->bClkRef = 0;
+      p->pLruPrev->pLruNext = p->pLruNext;
+      p->pLruNext->pLruPrev = p->pLruPrev;
+      p->pLruPrev = &pGroup->lru;
+      p->pLruNext = pGroup->lru.pLruNext;
+      p->pLruNext->pLruPrev = p;
+      pGroup->lru.pLruNext = p;
+    }
+    p = pPrev;
+  }
+  return 0;
+}
+#endif /* SQLITE_ENABLE_CLOCK_PCACHE */
+
 
 /*
 ** Remove the page supplied as an argument from the hash table
@@ -623,7 +705,11 @@ static void pcache1EnforceMaxPage(PCache1 *pCache){
   PgHdr1 *p;
   assert( sqlite3_mutex_held(pGroup->mutex) );
   while( pGroup->nPurgeable>pGroup->nMaxPage
+#ifdef SQLITE_ENABLE_CLOCK_PCACHE
+      && (p = pcache1ClockVictim(pGroup))!=0
+#else
       && (p=pGroup->lru.pLruPrev)->isAnchor==0
+#endif
   ){
     assert( p->pCache->pGroup==pGroup );
     assert( PAGE_IS_UNPINNED(p) );
@@ -633,6 +719,7 @@ static void pcache1EnforceMaxPage(PCache1 *pCache){
   if( pCache->nPage==0 && pCache->pBulk ){
     sqlite3_free(pCache->pBulk);
     pCache->pBulk = pCache->pFree = 0;
+    pCache->nBulkFree = 0;
   }
 }
 
@@ -675,7 +762,7 @@ static void pcache1TruncateUnsafe(
       if( pPage->iKey>=iLimit ){
         pCache->nPage--;
         *pp = pPage->pNext;
-        if( PAGE_IS_UNPINNED(pPage) ) pcache1PinPage(pPage);
+        if( pPage->pLruNext ) pcache1PinPage(pPage);
         pcache1FreePage(pPage);
       }else{
         pp = &pPage->pNext;
@@ -902,16 +989,22 @@ static SQLITE_NOINLINE PgHdr1 *pcache1FetchStage2(
    && ((pCache->nPage+1>=pCache->nMax) || pcache1UnderMemoryPressure(pCache))
   ){
     PCache1 *pOther;
+#ifdef SQLITE_ENABLE_CLOCK_PCACHE
+    pPage = pcache1ClockVictim(pGroup);
+#else
     pPage = pGroup->lru.pLruPrev;
-    assert( PAGE_IS_UNPINNED(pPage) );
-    pcache1RemoveFromHash(pPage, 0);
-    pcache1PinPage(pPage);
-    pOther = pPage->pCache;
-    if( pOther->szAlloc != pCache->szAlloc ){
-      pcache1FreePage(pPage);
-      pPage = 0;
-    }else{
-      pGroup->nPurgeable -= (pOther->bPurgeable - pCache->bPurgeable);
+#endif
+    if( pPage ){
+      assert( PAGE_IS_UNPINNED(pPage) );
+      pcache1RemoveFromHash(pPage, 0);
+      pcache1PinPage(pPage);
+      pOther = pPage->pCache;
+      if( pOther->szAlloc != pCache->szAlloc ){
+        pcache1FreePage(pPage);
+        pPage = 0;
+      }else{
+        pGroup->nPurgeable -= (pOther->bPurgeable - pCache->bPurgeable);
+      }
     }
   }
 
@@ -1017,7 +1110,16 @@ static PgHdr1 *pcache1FetchNoMutex(
   ** subsequent steps to try to create the page. */
   if( pPage ){
     if( PAGE_IS_UNPINNED(pPage) ){
+#ifdef SQLITE_ENABLE_CLOCK_PCACHE
+      /* Pin the page in place: no list surgery on the hot hit path.
+      ** The eviction scan skips pinned entries. */
+      pPage->isPinned = 1;
+      pPage->bClkRef = 1;
+      pPage->pCache->nRecyclable--;
+      return pPage;
+#else
       return pcache1PinPage(pPage);
+#endif
     }else{
       return pPage;
     }
@@ -1087,14 +1189,26 @@ static void pcache1Unpin(
   assert( pPage->pCache==pCache );
   pcache1EnterMutex(pGroup);
 
-  /* It is an error to call this function if the page is already
-  ** part of the PGroup LRU list.
+  /* Unless running in clock mode, it is an error to call this function
+  ** if the page is already part of the PGroup LRU list.
   */
+#ifndef SQLITE_ENABLE_CLOCK_PCACHE
   assert( pPage->pLruNext==0 );
+#endif
   assert( PAGE_IS_PINNED(pPage) );
 
   if( reuseUnlikely || pGroup->nPurgeable>pGroup->nMaxPage ){
+    if( pPage->pLruNext ) pcache1PinPage(pPage);
     pcache1RemoveFromHash(pPage, 1);
+#ifdef SQLITE_ENABLE_CLOCK_PCACHE
+  }else if( pPage->pLruNext ){
+    /* The page was clock-pinned in place: clearing the pin is all that
+    ** is needed to make it recyclable again. */
+    assert( pPage->isPinned );
+    pPage->isPinned = 0;
+    pPage->bClkRef = 1;
+    pCache->nRecyclable++;
+#endif
   }else{
     /* Add the page to the PGroup LRU list. */
     PgHdr1 **ppFirst = &pGroup->lru.pLruNext;
@@ -1241,8 +1355,12 @@ int sqlite3PcacheReleaseMemory(int nReq){
     PgHdr1 *p;
     pcache1EnterMutex(&pcache1.grp);
     while( (nReq<0 || nFree<nReq)
+#ifdef SQLITE_ENABLE_CLOCK_PCACHE
+       &&  (p = pcache1ClockVictim(&pcache1.grp))!=0
+#else
        &&  (p=pcache1.grp.lru.pLruPrev)!=0
        &&  p->isAnchor==0
+#endif
     ){
       nFree += pcache1MemSize(p->page.pBuf);
       assert( PAGE_IS_UNPINNED(p) );
@@ -222,8 +222,11 @@ static void setAllPagerFlags(sqlite3 *db){
     assert( (pDb->safety_level & PAGER_SYNCHRONOUS_MASK)==pDb->safety_level );
     while( (n--) > 0 ){
       if( pDb->pBt ){
-        sqlite3BtreeSetPagerFlags(pDb->pBt,
-                 pDb->safety_level | (db->flags & PAGER_FLAGS_MASK) );
+        unsigned pgFlags = pDb->safety_level | (db->flags & PAGER_FLAGS_MASK);
+        if( db->flags & SQLITE_GroupCommit ) pgFlags |= PAGER_GROUP_COMMIT;
+        if( db->flags & SQLITE_ConcurrentWr ) pgFlags |= PAGER_CONCURRENT;
+        if( db->flags & SQLITE_WalCompress ) pgFlags |= PAGER_WAL_COMPRESS;
+        sqlite3BtreeSetPagerFlags(pDb->pBt, pgFlags);
       }
       pDb++;
     }
@@ -2367,6 +2370,74 @@ void sqlite3Pragma(
     break;
   }
 
+  /*
+  **   PRAGMA analyze_incremental
+  **   PRAGMA analyze_incremental = N
+  **
+  ** Refresh statistics for tables whose content has drifted since they
+  ** were last analyzed, instead of re-analyzing the whole schema the
+  ** way a bare ANALYZE does.  A table is re-analyzed when its estimated
+  ** size is at least double the size recorded in sqlite_stat1, or when
+  ** any of its indexes lacks statistics altogether.  If the optional N
+  ** argument is given it is applied as the analysis limit (see PRAGMA
+  ** analysis_limit) before the scan, bounding the work spent on each
+  ** index, so a periodic "analyze_incremental=1000" is a cheap,
+  ** bounded-time top-up.
+  */
+  case PragTyp_ANALYZE_INCREMENTAL: {
+    int iDbLast;           /* Loop termination point for the schema loop */
+    int iTabCur;           /* Cursor for a table whose size needs checking */
+    HashElem *k;           /* Loop over tables of a schema */
+    Schema *pSchema;       /* The current schema */
+    Table *pTab;           /* A table in the schema */
+    Index *pIdx;           /* An index of the table */
+    LogEst szThreshold;    /* Size threshold above which reanalysis needed */
+    char *zSubSql;         /* SQL statement for the OP_SqlExec opcode */
+
+    if( zRight ){
+      sqlite3_int64 N;
+      if( sqlite3DecOrHexToI64(zRight, &N)==SQLITE_OK && N>=0 ){
+        db->nAnalysisLimit = (int)(N&0x7fffffff);
+      }
+    }
+    iTabCur = pParse->nTab++;
+    for(iDbLast = zDb?iDb:db->nDb-1; iDb<=iDbLast; iDb++){
+      if( iDb==1 ) continue;
+      sqlite3CodeVerifySchema(pParse, iDb);
+      pSchema = db->aDb[iDb].pSchema;
+      for(k=sqliteHashFirst(&pSchema->tblHash); k; k=sqliteHashNext(k)){
+        pTab = (Table*)sqliteHashData(k);
+        if( !IsOrdinaryTable(pTab) ) continue;
+
+        /* Re-analyze when the table has doubled since the last analysis,
+        ** when it has never been analyzed, or when any of its indexes is
+        ** missing statistics */
+        if( (pTab->tabFlags & TF_HasStat1)==0 ){
+          szThreshold = 0;
+        }else{
+          szThreshold = pTab->nRowLogEst + 10;  assert( sqlite3LogEst(2)==10 );
+          for(pIdx=pTab->pIndex; pIdx; pIdx=pIdx->pNext){
+            if( !pIdx->hasStat1 ){
+              szThreshold = 0;
+              break;
+            }
+          }
+        }
+        if( szThreshold ){
+          sqlite3OpenTable(pParse, iTabCur, iDb, pTab, OP_OpenRead);
+          sqlite3VdbeAddOp3(v, OP_IfSmaller, iTabCur,
+                            sqlite3VdbeCurrentAddr(v)+2, szThreshold);
+          VdbeCoverage(v);
+        }
+        zSubSql = sqlite3MPrintf(db, "ANALYZE \"%w\".\"%w\"",
+                                 db->aDb[iDb].zDbSName, pTab->zName);
+        sqlite3VdbeAddOp4(v, OP_SqlExec, 0, 0, 0, zSubSql, P4_DYNAMIC);
+      }
+    }
+    sqlite3VdbeAddOp0(v, OP_Expire);
+    break;
+  }
+
   /*
   **  PRAGMA optimize
   **  PRAGMA optimize(MASK)
@@ -2577,6 +2648,53 @@ void sqlite3Pragma(
     break;
   }
 
+#ifndef SQLITE_OMIT_AUTOVACUUM
+  /*
+  **   PRAGMA autovacuum_pages
+  **   PRAGMA autovacuum_pages = N
+  **
+  ** Cap the number of pages reclaimed from the freelist by each commit
+  ** of an auto-vacuum database, like an sqlite3_autovacuum_pages()
+  ** callback returning the constant N.  Zero (the default) reclaims the
+  ** whole freelist.  A callback registered through the C interface
+  ** takes precedence over this setting.
+  */
+  case PragTyp_AUTOVACUUM_PAGES: {
+    sqlite3_int64 N;
+    if( zRight
+     && sqlite3DecOrHexToI64(zRight, &N)==SQLITE_OK
+     && N>=0
+    ){
+      db->nAutovacPageLimit = (int)(N&0x7fffffff);
+    }
+    returnSingleInt(v, db->nAutovacPageLimit);
+    break;
+  }
+#endif
+
+#ifndef SQLITE_OMIT_WAL
+  /*
+  **   PRAGMA checkpoint_workers
+  **   PRAGMA checkpoint_workers = N
+  **
+  ** Configure the number of threads used to copy frames back into the
+  ** database file during a WAL checkpoint.  Values of 0 or 1 select the
+  ** single-threaded backfill.  The upper bound is SQLITE_MAX_WORKER_THREADS.
+  */
+  case PragTyp_CHECKPOINT_WORKERS: {
+    sqlite3_int64 N;
+    if( zRight
+     && sqlite3DecOrHexToI64(zRight, &N)==SQLITE_OK
+     && N>=0
+    ){
+      if( N>SQLITE_MAX_WORKER_THREADS ) N = SQLITE_MAX_WORKER_THREADS;
+      db->nCkptWorker = (int)N;
+    }
+    returnSingleInt(v, db->nCkptWorker);
+    break;
+  }
+#endif
+
 #if defined(SQLITE_DEBUG) || defined(SQLITE_TEST)
   /*
   ** Report the current state of file logs for all databases
@@ -7,50 +7,53 @@
 /* The various pragma types */
 #define PragTyp_ACTIVATE_EXTENSIONS            0
 #define PragTyp_ANALYSIS_LIMIT                 1
-#define PragTyp_HEADER_VALUE                   2
-#define PragTyp_AUTO_VACUUM                    3
-#define PragTyp_FLAG                           4
-#define PragTyp_BUSY_TIMEOUT                   5
-#define PragTyp_CACHE_SIZE                     6
-#define PragTyp_CACHE_SPILL                    7
-#define PragTyp_CASE_SENSITIVE_LIKE            8
-#define PragTyp_COLLATION_LIST                 9
-#define PragTyp_COMPILE_OPTIONS               10
-#define PragTyp_DATA_STORE_DIRECTORY          11
-#define PragTyp_DATABASE_LIST                 12
-#define PragTyp_DEFAULT_CACHE_SIZE            13
-#define PragTyp_ENCODING                      14
-#define PragTyp_FOREIGN_KEY_CHECK             15
-#define PragTyp_FOREIGN_KEY_LIST              16
-#define PragTyp_FUNCTION_LIST                 17
-#define PragTyp_HARD_HEAP_LIMIT               18
-#define PragTyp_INCREMENTAL_VACUUM            19
-#define PragTyp_INDEX_INFO                    20
-#define PragTyp_INDEX_LIST                    21
-#define PragTyp_INTEGRITY_CHECK               22
-#define PragTyp_JOURNAL_MODE                  23
-#define PragTyp_JOURNAL_SIZE_LIMIT            24
-#define PragTyp_LOCK_PROXY_FILE               25
-#define PragTyp_LOCKING_MODE                  26
-#define PragTyp_PAGE_COUNT                    27
-#define PragTyp_MMAP_SIZE                     28
-#define PragTyp_MODULE_LIST                   29
-#define PragTyp_OPTIMIZE                      30
-#define PragTyp_PAGE_SIZE                     31
-#define PragTyp_PRAGMA_LIST                   32
-#define PragTyp_SECURE_DELETE                 33
-#define PragTyp_SHRINK_MEMORY                 34
-#define PragTyp_SOFT_HEAP_LIMIT               35
-#define PragTyp_SYNCHRONOUS                   36
-#define PragTyp_TABLE_INFO                    37
-#define PragTyp_TABLE_LIST                    38
-#define PragTyp_TEMP_STORE                    39
-#define PragTyp_TEMP_STORE_DIRECTORY          40
-#define PragTyp_THREADS                       41
-#define PragTyp_WAL_AUTOCHECKPOINT            42
-#define PragTyp_WAL_CHECKPOINT                43
-#define PragTyp_LOCK_STATUS                   44
-#define PragTyp_STATS                         45
+#define PragTyp_ANALYZE_INCREMENTAL            2
+#define PragTyp_HEADER_VALUE                   3
+#define PragTyp_AUTO_VACUUM                    4
+#define PragTyp_FLAG                           5
+#define PragTyp_AUTOVACUUM_PAGES               6
+#define PragTyp_BUSY_TIMEOUT                   7
+#define PragTyp_CACHE_SIZE                     8
+#define PragTyp_CACHE_SPILL                    9
+#define PragTyp_CASE_SENSITIVE_LIKE           10
+#define PragTyp_CHECKPOINT_WORKERS            11
+#define PragTyp_COLLATION_LIST                12
+#define PragTyp_COMPILE_OPTIONS               13
+#define PragTyp_DATA_STORE_DIRECTORY          14
+#define PragTyp_DATABASE_LIST                 15
+#define PragTyp_DEFAULT_CACHE_SIZE            16
+#define PragTyp_ENCODING                      17
+#define PragTyp_FOREIGN_KEY_CHECK             18
+#define PragTyp_FOREIGN_KEY_LIST              19
+#define PragTyp_FUNCTION_LIST                 20
+#define PragTyp_HARD_HEAP_LIMIT               21
+#define PragTyp_INCREMENTAL_VACUUM            22
+#define PragTyp_INDEX_INFO                    23
+#define PragTyp_INDEX_LIST                    24
+#define PragTyp_INTEGRITY_CHECK               25
+#define PragTyp_JOURNAL_MODE                  26
+#define PragTyp_JOURNAL_SIZE_LIMIT            27
+#define PragTyp_LOCK_PROXY_FILE               28
+#define PragTyp_LOCKING_MODE                  29
+#define PragTyp_PAGE_COUNT                    30
+#define PragTyp_MMAP_SIZE                     31
+#define PragTyp_MODULE_LIST                   32
+#define PragTyp_OPTIMIZE                      33
+#define PragTyp_PAGE_SIZE                     34
+#define PragTyp_PRAGMA_LIST                   35
+#define PragTyp_SECURE_DELETE                 36
+#define PragTyp_SHRINK_MEMORY                 37
+#define PragTyp_SOFT_HEAP_LIMIT               38
+#define PragTyp_SYNCHRONOUS                   39
+#define PragTyp_TABLE_INFO                    40
+#define PragTyp_TABLE_LIST                    41
+#define PragTyp_TEMP_STORE                    42
+#define PragTyp_TEMP_STORE_DIRECTORY          43
+#define PragTyp_THREADS                       44
+#define PragTyp_WAL_AUTOCHECKPOINT            45
+#define PragTyp_WAL_CHECKPOINT                46
+#define PragTyp_LOCK_STATUS                   47
+#define PragTyp_STATS                         48
 
 /* Property flags associated with various pragma. */
 #define PragFlg_NeedSchema 0x01 /* Force schema load before running */
@@ -152,6 +155,13 @@ static const PragmaName aPragmaName[] = {
   /* ePragFlg:  */ PragFlg_Result0,
   /* ColNames:  */ 0, 0,
   /* iArg:      */ 0 },
+#if !defined(SQLITE_OMIT_ANALYZE)
+ {/* zName:     */ "analyze_incremental",
+  /* ePragTyp:  */ PragTyp_ANALYZE_INCREMENTAL,
+  /* ePragFlg:  */ PragFlg_NeedSchema|PragFlg_NoColumns1,
+  /* ColNames:  */ 0, 0,
+  /* iArg:      */ 0 },
+#endif
 #if !defined(SQLITE_OMIT_SCHEMA_VERSION_PRAGMAS)
  {/* zName:     */ "application_id",
   /* ePragTyp:  */ PragTyp_HEADER_VALUE,
@@ -174,6 +184,13 @@ static const PragmaName aPragmaName[] = {
   /* ColNames:  */ 0, 0,
   /* iArg:      */ SQLITE_AutoIndex },
 #endif
+#endif
+#if !defined(SQLITE_OMIT_AUTOVACUUM)
+ {/* zName:     */ "autovacuum_pages",
+  /* ePragTyp:  */ PragTyp_AUTOVACUUM_PAGES,
+  /* ePragFlg:  */ PragFlg_Result0,
+  /* ColNames:  */ 0, 0,
+  /* iArg:      */ 0 },
 #endif
  {/* zName:     */ "busy_timeout",
   /* ePragTyp:  */ PragTyp_BUSY_TIMEOUT,
@@ -213,6 +230,13 @@ static const PragmaName aPragmaName[] = {
   /* ColNames:  */ 0, 0,
   /* iArg:      */ SQLITE_CkptFullFSync },
 #endif
+#if !defined(SQLITE_OMIT_WAL)
+ {/* zName:     */ "checkpoint_workers",
+  /* ePragTyp:  */ PragTyp_CHECKPOINT_WORKERS,
+  /* ePragFlg:  */ PragFlg_Result0,
+  /* ColNames:  */ 0, 0,
+  /* iArg:      */ 0 },
+#endif
 #if !defined(SQLITE_OMIT_SCHEMA_PRAGMAS)
  {/* zName:     */ "collation_list",
   /* ePragTyp:  */ PragTyp_COLLATION_LIST,
@@ -227,6 +251,13 @@ static const PragmaName aPragmaName[] = {
   /* ColNames:  */ 0, 0,
   /* iArg:      */ 0 },
 #endif
+#if !defined(SQLITE_OMIT_FLAG_PRAGMAS) && !defined(SQLITE_OMIT_WAL)
+ {/* zName:     */ "concurrent_writes",
+  /* ePragTyp:  */ PragTyp_FLAG,
+  /* ePragFlg:  */ PragFlg_Result0|PragFlg_NoColumns1,
+  /* ColNames:  */ 0, 0,
+  /* iArg:      */ SQLITE_ConcurrentWr },
+#endif
 #if !defined(SQLITE_OMIT_FLAG_PRAGMAS)
  {/* zName:     */ "count_changes",
   /* ePragTyp:  */ PragTyp_FLAG,
@@ -649,6 +680,20 @@ static const PragmaName aPragmaName[] = {
   /* ColNames:  */ 50, 3,
   /* iArg:      */ 0 },
 #endif
+#if !defined(SQLITE_OMIT_FLAG_PRAGMAS) && defined(SQLITE_ENABLE_WAL_COMPRESSION)
+ {/* zName:     */ "wal_compression",
+  /* ePragTyp:  */ PragTyp_FLAG,
+  /* ePragFlg:  */ PragFlg_Result0|PragFlg_NoColumns1,
+  /* ColNames:  */ 0, 0,
+  /* iArg:      */ SQLITE_WalCompress },
+#endif
+#if !defined(SQLITE_OMIT_FLAG_PRAGMAS) && !defined(SQLITE_OMIT_WAL)
+ {/* zName:     */ "wal_group_commit",
+  /* ePragTyp:  */ PragTyp_FLAG,
+  /* ePragFlg:  */ PragFlg_Result0|PragFlg_NoColumns1,
+  /* ColNames:  */ 0, 0,
+  /* iArg:      */ SQLITE_GroupCommit },
+#endif
 #if !defined(SQLITE_OMIT_FLAG_PRAGMAS)
  {/* zName:     */ "writable_schema",
   /* ePragTyp:  */ PragTyp_FLAG,
@@ -657,4 +702,4 @@ static const PragmaName aPragmaName[] = {
   /* iArg:      */ SQLITE_WriteSchema|SQLITE_NoSchemaError },
 #endif
 };
-/* Number of pragmas: 68 on by default, 78 total. */
+/* Number of pragmas: 73 on by default, 84 total. */
@@ -572,6 +572,40 @@ int sqlite3SchemaToIndex(sqlite3 *db, Schema *pSchema){
   return i;
 }
 
+
+
+/* Size of each parse-arena block, including the next-block link */
+#define PARSE_ARENA_BLKSZ 4096
+
+/*
+** Allocate nByte bytes from the parse arena of pParse.  Returns NULL if
+** the arena is disabled for this parse, if nByte is too large for an
+** arena block, or on OOM; the caller then falls back to an ordinary
+** allocation.  Arena memory is released wholesale by
+** sqlite3ParseObjectReset(), so objects placed here must not outlive
+** the parse - which is why the arena is only enabled for statements
+** that begin with a DML keyword (see sqlite3RunParser): DDL statements
+** hand expression trees to schema objects.
+*/
+void *sqlite3ParseArenaAlloc(Parse *pParse, u64 nByte){
+  void *pRet;
+  if( !pParse->okArena ) return 0;
+  nByte = ROUND8(nByte);
+  if( nByte > PARSE_ARENA_BLKSZ-ROUND8(sizeof(void*)) ) return 0;
+  if( (u64)pParse->nArenaFree < nByte ){
+    void *pNew = sqlite3DbMallocRaw(pParse->db, PARSE_ARENA_BLKSZ);
+    if( pNew==0 ) return 0;
+    *(void**)pNew = pParse->pArenaBlk;
+    pParse->pArenaBlk = pNew;
+    pParse->zArenaFree = (char*)pNew + ROUND8(sizeof(void*));
+    pParse->nArenaFree = PARSE_ARENA_BLKSZ - (int)ROUND8(sizeof(void*));
+  }
+  pRet = pParse->zArenaFree;
+  pParse->zArenaFree += nByte;
+  pParse->nArenaFree -= (int)nByte;
+  return pRet;
+}
+
 /*
 ** Free all memory allocations in the pParse object
 */
@@ -593,6 +627,15 @@ void sqlite3ParseObjectReset(Parse *pParse){
   if( pParse->pConstExpr ){
     sqlite3ExprListDelete(db, pParse->pConstExpr);
   }
+  while( pParse->pArenaBlk ){
+    /* Wholesale release of arena-allocated expression nodes.  This must
+    ** come after every piece of cleanup that may still walk expression
+    ** trees (EP_Arena nodes are skipped by sqlite3ExprDelete, but their
+    ** children may live here too). */
+    void *pBlk = pParse->pArenaBlk;
+    pParse->pArenaBlk = *(void**)pBlk;
+    sqlite3DbNNFreeNN(db, pBlk);
+  }
   assert( db->lookaside.bDisable >= pParse->disableLookaside );
   db->lookaside.bDisable -= pParse->disableLookaside;
   db->lookaside.sz = db->lookaside.bDisable ? 0 : db->lookaside.szTrue;
@@ -1076,3 +1119,122 @@ int sqlite3_prepare16_v3(
 }
 
 #endif /* SQLITE_OMIT_UTF16 */
+
+
+/*
+** Cached prepared statements (libsql_prepare_cached() and
+** libsql_release_cached_stmt()).
+**
+** A per-connection cache of idle prepared statements keyed by SQL text.
+** libsql_prepare_cached() hands out a matching idle statement, already
+** reset, instead of running the parser and code generator again;
+** libsql_release_cached_stmt() resets a statement and returns it to the
+** cache.  Statements recompile themselves on schema change through the
+** normal SQLITE_SCHEMA handling in sqlite3_step(), so no cookie check
+** is needed here.
+**
+** The cache is deliberately per-connection.  A process-wide cache that
+** clones frozen Vdbe programs between connections is not sound in this
+** architecture: programs embed connection-local pointers (CollSeq from
+** db->aCollSeq, FuncDef for application functions, Schema objects when
+** not in shared-cache mode) that cannot be remapped without doing the
+** code generator's work over again.
+*/
+typedef struct CachedStmt CachedStmt;
+struct CachedStmt {
+  char *zSql;                   /* SQL text of the cached statement */
+  sqlite3_stmt *pStmt;          /* The idle prepared statement */
+  CachedStmt *pNext;            /* Next entry in sqlite3.pStmtCache */
+};
+
+/* Maximum number of idle statements kept per connection */
+#define SQLITE_STMTCACHE_MAX 64
+
+/* Discard every entry in the statement cache of db.  Called when the
+** connection closes. */
+void sqlite3StmtCacheClear(sqlite3 *db){
+  CachedStmt *p, *pNext;
+  for(p=db->pStmtCache; p; p=pNext){
+    pNext = p->pNext;
+    sqlite3_finalize(p->pStmt);
+    sqlite3DbFree(db, p->zSql);
+    sqlite3DbFree(db, p);
+  }
+  db->pStmtCache = 0;
+  db->nStmtCache = 0;
+}
+
+/*
+** Prepare zSql, preferring an idle cached statement with identical text.
+*/
+int libsql_prepare_cached(
+  sqlite3 *db,                  /* Database handle */
+  const char *zSql,             /* SQL statement, UTF-8 encoded */
+  int nByte,                    /* Maximum length of zSql in bytes, or -1 */
+  sqlite3_stmt **ppStmt         /* OUT: Statement handle */
+){
+  CachedStmt *p, **pp;
+  int rc;
+  if( ppStmt==0 ) return SQLITE_MISUSE_BKPT;
+  *ppStmt = 0;
+  if( !sqlite3SafetyCheckOk(db)||zSql==0 ) return SQLITE_MISUSE_BKPT;
+  sqlite3_mutex_enter(db->mutex);
+  for(pp=&db->pStmtCache; (p = *pp)!=0; pp=&p->pNext){
+    /* When nByte exceeds the cached SQL's length (callers may pass any
+    ** upper bound, e.g. strlen+1 or larger), fall back to strcmp():
+    ** indexing p->zSql[nByte] would read past its allocation, and
+    ** strcmp() stops at the cached NUL which is always within the
+    ** caller's nByte bytes of zSql. */
+    int n = sqlite3Strlen30(p->zSql);
+    if( ((nByte<0 || nByte>n)
+           ? strcmp(p->zSql, zSql)==0
+           : (strncmp(p->zSql, zSql, nByte)==0 && p->zSql[nByte]==0)) ){
+      *pp = p->pNext;
+      db->nStmtCache--;
+      *ppStmt = p->pStmt;
+      sqlite3DbFree(db, p->zSql);
+      sqlite3DbFree(db, p);
+      sqlite3_mutex_leave(db->mutex);
+      return SQLITE_OK;
+    }
+  }
+  sqlite3_mutex_leave(db->mutex);
+  rc = sqlite3_prepare_v3(db, zSql, nByte, SQLITE_PREPARE_PERSISTENT,
+                          ppStmt, 0);
+  return rc;
+}
+
+/*
+** Return an idle statement to the connection's cache.  On any failure
+** (OOM, cache full) the statement is finalized instead; either way the
+** caller must not use pStmt again.
+*/
+int libsql_release_cached_stmt(sqlite3_stmt *pStmt){
+  sqlite3 *db;
+  CachedStmt *p;
+  const char *zSql;
+  if( pStmt==0 ) return SQLITE_OK;
+  db = sqlite3_db_handle(pStmt);
+  zSql = sqlite3_sql(pStmt);
+  sqlite3_reset(pStmt);
+  sqlite3_clear_bindings(pStmt);
+  sqlite3_mutex_enter(db->mutex);
+  if( zSql==0 || db->nStmtCache>=SQLITE_STMTCACHE_MAX
+   || (p = (CachedStmt*)sqlite3DbMallocZero(db, sizeof(CachedStmt)))==0
+  ){
+    sqlite3_mutex_leave(db->mutex);
+    return sqlite3_finalize(pStmt);
+  }
+  p->zSql = sqlite3DbStrDup(db, zSql);
+  if( p->zSql==0 ){
+    sqlite3DbFree(db, p);
+    sqlite3_mutex_leave(db->mutex);
+    return sqlite3_finalize(pStmt);
+  }
+  p->pStmt = pStmt;
+  p->pNext = db->pStmtCache;
+  db->pStmtCache = p;
+  db->nStmtCache++;
+  sqlite3_mutex_leave(db->mutex);
+  return SQLITE_OK;
+}
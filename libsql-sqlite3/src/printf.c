@@ -235,6 +235,30 @@ void sqlite3_str_vappendf(
       sqlite3_str_append(pAccum, "%", 1);
       break;
     }
+    /* Fast paths for the two conversions that dominate row rendering
+    ** and log formatting - plain %s and %d with no flags, width or
+    ** precision - skipping the option-parsing machinery below. */
+    if( c=='s' && !bArgList ){
+      bufpt = va_arg(ap,char*);
+      if( bufpt==0 ) bufpt = "";
+      sqlite3_str_appendall(pAccum, bufpt);
+      bufpt = 0;
+      continue;
+    }
+    if( c=='d' && !bArgList ){
+      char *zEnd = &buf[24];
+      char *z = zEnd;
+      int v = va_arg(ap,int);
+      unsigned int u = v>=0 ? (unsigned int)v : ~(unsigned int)v + 1u;
+      do{
+        *(--z) = (char)('0' + u%10);
+        u /= 10;
+      }while( u );
+      if( v<0 ) *(--z) = '-';
+      sqlite3_str_append(pAccum, z, (int)(zEnd-z));
+      bufpt = 0;
+      continue;
+    }
     /* Find out what flags are present */
     flag_leftjustify = flag_prefix = cThousand =
      flag_alternateform = flag_altform2 = flag_zeropad = 0;
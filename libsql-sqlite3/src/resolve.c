@@ -91,9 +91,18 @@ static void resolveAlias(
       assert( !ExprHasProperty(pExpr, EP_IntValue) );
       pDup = sqlite3ExprAddCollateString(pParse, pDup, pExpr->u.zToken);
     }
-    memcpy(&temp, pDup, sizeof(Expr));
-    memcpy(pDup, pExpr, sizeof(Expr));
-    memcpy(pExpr, &temp, sizeof(Expr));
+    {
+      /* Swap the contents of pExpr and pDup, but keep the EP_Static and
+      ** EP_Arena properties with the allocations they describe rather
+      ** than with the contents. */
+      u32 fExpr = pExpr->flags & (EP_Static|EP_Arena);
+      u32 fDup = pDup->flags & (EP_Static|EP_Arena);
+      memcpy(&temp, pDup, sizeof(Expr));
+      memcpy(pDup, pExpr, sizeof(Expr));
+      memcpy(pExpr, &temp, sizeof(Expr));
+      pExpr->flags = (pExpr->flags & ~(EP_Static|EP_Arena)) | fExpr;
+      pDup->flags = (pDup->flags & ~(EP_Static|EP_Arena)) | fDup;
+    }
     if( ExprHasProperty(pExpr, EP_WinFunc) ){
       if( ALWAYS(pExpr->y.pWin!=0) ){
         pExpr->y.pWin->pOwner = pExpr;
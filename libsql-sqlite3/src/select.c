@@ -1380,6 +1380,11 @@ static void selectInnerLoop(
         sqlite3VdbeAddOp4(v, OP_MakeRecord, regResult, nResultCol,
             r1, pDest->zAffSdst, nResultCol);
         sqlite3VdbeAddOp4Int(v, OP_IdxInsert, iParm, r1, regResult, nResultCol);
+        if( pDest->iSDParm2 ){
+          /* Also add the key to the IN operator's Bloom filter */
+          sqlite3VdbeAddOp4Int(v, OP_FilterAdd, pDest->iSDParm2, 0,
+                               regResult, nResultCol);
+        }
         sqlite3ReleaseTempReg(pParse, r1);
       }
       break;
@@ -1804,6 +1809,10 @@ static void generateSortTail(
       sqlite3VdbeAddOp4(v, OP_MakeRecord, regRow, nColumn, regRowid,
                         pDest->zAffSdst, nColumn);
       sqlite3VdbeAddOp4Int(v, OP_IdxInsert, iParm, regRowid, regRow, nColumn);
+      if( pDest->iSDParm2 ){
+        sqlite3VdbeAddOp4Int(v, OP_FilterAdd, pDest->iSDParm2, 0,
+                             regRow, nColumn);
+      }
       break;
     }
     case SRT_Mem: {
@@ -3308,6 +3317,10 @@ static int generateOutputSubroutine(
           r1, pDest->zAffSdst, pIn->nSdst);
       sqlite3VdbeAddOp4Int(v, OP_IdxInsert, pDest->iSDParm, r1,
                            pIn->iSdst, pIn->nSdst);
+      if( pDest->iSDParm2 ){
+        sqlite3VdbeAddOp4Int(v, OP_FilterAdd, pDest->iSDParm2, 0,
+                             pIn->iSdst, pIn->nSdst);
+      }
       sqlite3ReleaseTempReg(pParse, r1);
       break;
     }
@@ -8124,6 +8137,17 @@ int sqlite3Select(
       VdbeComment((v, "clear abort flag"));
       sqlite3VdbeAddOp3(v, OP_Null, 0, iAMem, iAMem+pGroupBy->nExpr-1);
 
+      /* Partial-order streaming (aggregating per prefix-run and
+      ** sorting only within runs when the scan delivers a proper
+      ** prefix of the GROUP BY terms) is not implemented on this
+      ** path.  The block-sort machinery that pushOntoSorter() uses
+      ** for ORDER BY (SortCtx.nOBSat) is the right foundation, but
+      ** this aggregate arm drives its sorter directly and drains it
+      ** after WhereEnd, so per-run draining needs the output stage
+      ** restructured as a subroutine first.  Until then the choice
+      ** is binary: fully delivered order streams, anything else pays
+      ** a full sorter pass. */
+
       /* Begin a loop that will extract all source rows in GROUP BY order.
       ** This might involve two separate loops with an OP_Sort in between, or
       ** it might be a single loop that uses an index to extract information
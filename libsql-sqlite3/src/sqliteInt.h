@@ -1545,10 +1545,13 @@ struct Lookaside {
   LookasideSlot *pInit;   /* List of buffers not previously used */
   LookasideSlot *pFree;   /* List of available buffers */
 #ifndef SQLITE_OMIT_TWOSIZE_LOOKASIDE
+  LookasideSlot *pMidInit;   /* List of mid-size buffers not previously used */
+  LookasideSlot *pMidFree;   /* List of available mid-size buffers */
   LookasideSlot *pSmallInit; /* List of small buffers not previously used */
   LookasideSlot *pSmallFree; /* List of available small buffers */
   void *pMiddle;          /* First byte past end of full-size buffers and
-                          ** the first byte of LOOKASIDE_SMALL buffers */
+                          ** the first byte of LOOKASIDE_MID buffers */
+  void *pSmallStart;      /* First byte of LOOKASIDE_SMALL buffers */
 #endif /* SQLITE_OMIT_TWOSIZE_LOOKASIDE */
   void *pStart;           /* First byte of available memory space */
   void *pEnd;             /* First byte past end of available space */
@@ -1562,10 +1565,14 @@ struct LookasideSlot {
 #define EnableLookaside   db->lookaside.bDisable--;\
    db->lookaside.sz=db->lookaside.bDisable?0:db->lookaside.szTrue
 
-/* Size of the smaller allocations in two-size lookaside */
+/* Sizes of the smaller allocation classes in multi-size lookaside.
+** LOOKASIDE_MID catches the Expr-and-friends traffic that overflows
+** the 128-byte class but is far below the full slot size. */
 #ifdef SQLITE_OMIT_TWOSIZE_LOOKASIDE
 #  define LOOKASIDE_SMALL           0
+#  define LOOKASIDE_MID             0
 #else
+#  define LOOKASIDE_MID           256
 #  define LOOKASIDE_SMALL         128
 #endif
 
@@ -1703,6 +1710,9 @@ struct sqlite3 {
   int nVDestroy;                /* Number of active OP_VDestroy operations */
   int nExtension;               /* Number of loaded extensions */
   void **aExtension;            /* Array of shared library handles */
+  struct CachedStmt *pStmtCache; /* List of statements kept by
+                                 ** libsql_prepare_cached() */
+  int nStmtCache;               /* Number of entries in pStmtCache */
   union {
     void (*xLegacy)(void*,const char*);   /* mTrace==SQLITE_TRACE_LEGACY */
     int (*xV2)(u32,void*,void*,void*);    /* All other mTrace values */
@@ -1764,6 +1774,8 @@ struct sqlite3 {
   Db aDbStatic[2];              /* Static space for the 2 default backends */
   Savepoint *pSavepoint;        /* List of active savepoints */
   int nAnalysisLimit;           /* Number of index rows to ANALYZE */
+  int nCkptWorker;              /* Worker threads for WAL checkpoint backfill */
+  int nAutovacPageLimit;        /* Max pages reclaimed per auto-vacuum commit */
   int busyTimeout;              /* Busy handler timeout, in msec */
   int nSavepoint;               /* Number of non-transaction savepoints */
   int nStatement;               /* Number of nested statement-transactions  */
@@ -1864,6 +1876,9 @@ struct sqlite3 {
 #define SQLITE_CorruptRdOnly  HI(0x00002) /* Prohibit writes due to error */
 #define SQLITE_ReadUncommit   HI(0x00004) /* READ UNCOMMITTED in shared-cache */
 #define SQLITE_FkNoAction     HI(0x00008) /* Treat all FK as NO ACTION */
+#define SQLITE_GroupCommit    HI(0x00010) /* PRAGMA wal_group_commit=ON */
+#define SQLITE_ConcurrentWr   HI(0x00020) /* PRAGMA concurrent_writes=ON */
+#define SQLITE_WalCompress    HI(0x00040) /* PRAGMA wal_compression=ON */
 
 /* Flags used only if debugging */
 #ifdef SQLITE_DEBUG
@@ -3084,7 +3099,7 @@ struct Expr {
 #define EP_IsTrue   0x10000000 /* Always has boolean value of TRUE */
 #define EP_IsFalse  0x20000000 /* Always has boolean value of FALSE */
 #define EP_FromDDL  0x40000000 /* Originates from sqlite_schema */
-               /*   0x80000000 // Available */
+#define EP_Arena    0x80000000 /* Node allocated from the Parse arena */
 
 /* The EP_Propagate mask is a set of properties that automatically propagate
 ** upwards into parent nodes.
@@ -3795,6 +3810,11 @@ struct ParseCleanup {
 struct Parse {
   sqlite3 *db;         /* The main database structure */
   char *zErrMsg;       /* An error message */
+  char *zArenaFree;    /* Next free byte in the current parse-arena block */
+  int nArenaFree;      /* Bytes remaining in the current parse-arena block */
+  void *pArenaBlk;     /* List of arena blocks; first word links to next */
+  u8 okArena;          /* Allocate expression nodes from the parse arena */
+  int regInFilter;     /* Bloom filter for the most recent IN(SELECT) RHS */
   Vdbe *pVdbe;         /* An engine for executing database bytecode */
   int rc;              /* Return code from execution */
   u8 colNamesSet;      /* TRUE after OP_ColumnName has been issued to pVdbe */
@@ -4471,6 +4491,8 @@ struct Window {
   int iArgCol;            /* Offset of first argument for this function */
   int regOne;             /* Register containing constant value 1 */
   int regStartRowid;
+  int regMemoStart;       /* Frame-start rowid of the last full scan */
+  int regMemoEnd;         /* Frame-end rowid of the last full scan */
   int regEndRowid;
   u8 bExprArgs;           /* Defer evaluation of window function arguments
                           ** due to the SQLITE_SUBTYPE flag */
@@ -4599,6 +4621,7 @@ int sqlite3IsIdChar(u8);
 ** Internal function prototypes
 */
 int sqlite3StrICmp(const char*,const char*);
+int sqlite3StrNICmpBounded(const char*,const char*,int);
 int sqlite3Strlen30(const char*);
 #define sqlite3Strlen30NN(C) (strlen(C)&0x3fffffff)
 char *sqlite3ColumnType(Column*,char*);
@@ -5507,6 +5530,8 @@ sqlite3_int64 sqlite3StmtCurrentTime(sqlite3_context*);
 int sqlite3VdbeParameterIndex(Vdbe*, const char*, int);
 int sqlite3TransferBindings(sqlite3_stmt *, sqlite3_stmt *);
 void sqlite3ParseObjectInit(Parse*,sqlite3*);
+void *sqlite3ParseArenaAlloc(Parse*, u64);
+void sqlite3StmtCacheClear(sqlite3*);
 void sqlite3ParseObjectReset(Parse*);
 void *sqlite3ParserAddCleanup(Parse*,void(*)(sqlite3*,void*),void*);
 #ifdef SQLITE_ENABLE_NORMALIZE
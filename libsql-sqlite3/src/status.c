@@ -189,6 +189,8 @@ int sqlite3LookasideUsed(sqlite3 *db, int *pHighwater){
   u32 nInit = countLookasideSlots(db->lookaside.pInit);
   u32 nFree = countLookasideSlots(db->lookaside.pFree);
 #ifndef SQLITE_OMIT_TWOSIZE_LOOKASIDE
+  nInit += countLookasideSlots(db->lookaside.pMidInit);
+  nFree += countLookasideSlots(db->lookaside.pMidFree);
   nInit += countLookasideSlots(db->lookaside.pSmallInit);
   nFree += countLookasideSlots(db->lookaside.pSmallFree);
 #endif /* SQLITE_OMIT_TWOSIZE_LOOKASIDE */
@@ -243,6 +245,13 @@ int sqlite3_db_status(
           db->lookaside.pFree = 0;
         }
 #ifndef SQLITE_OMIT_TWOSIZE_LOOKASIDE
+        p = db->lookaside.pMidFree;
+        if( p ){
+          while( p->pNext ) p = p->pNext;
+          p->pNext = db->lookaside.pMidInit;
+          db->lookaside.pMidInit = db->lookaside.pMidFree;
+          db->lookaside.pMidFree = 0;
+        }
         p = db->lookaside.pSmallFree;
         if( p ){
           while( p->pNext ) p = p->pNext;
@@ -374,8 +383,8 @@ int sqlite3_db_status(
     ** to zero.
     */
     case SQLITE_DBSTATUS_CACHE_SPILL:
-      op = SQLITE_DBSTATUS_CACHE_WRITE+1;
-      /* no break */ deliberate_fall_through
+    case SQLITE_DBSTATUS_CACHE_READ_WAL:
+    case SQLITE_DBSTATUS_FILE_SYNC:
     case SQLITE_DBSTATUS_CACHE_HIT:
     case SQLITE_DBSTATUS_CACHE_MISS:
     case SQLITE_DBSTATUS_CACHE_WRITE:{
@@ -383,6 +392,16 @@ int sqlite3_db_status(
       int nRet = 0;
       assert( SQLITE_DBSTATUS_CACHE_MISS==SQLITE_DBSTATUS_CACHE_HIT+1 );
       assert( SQLITE_DBSTATUS_CACHE_WRITE==SQLITE_DBSTATUS_CACHE_HIT+2 );
+      /* The _SPILL, _READ_WAL and _FILE_SYNC codes are not contiguous
+      ** with the other cache statistics, so translate them into the
+      ** internal WRITE+N encoding used by sqlite3PagerCacheStat() */
+      if( op==SQLITE_DBSTATUS_CACHE_SPILL ){
+        op = SQLITE_DBSTATUS_CACHE_WRITE+1;
+      }else if( op==SQLITE_DBSTATUS_CACHE_READ_WAL ){
+        op = SQLITE_DBSTATUS_CACHE_WRITE+2;
+      }else if( op==SQLITE_DBSTATUS_FILE_SYNC ){
+        op = SQLITE_DBSTATUS_CACHE_WRITE+3;
+      }
 
       for(i=0; i<db->nDb; i++){
         if( db->aDb[i].pBt ){
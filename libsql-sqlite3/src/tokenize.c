@@ -612,6 +612,30 @@ int sqlite3RunParser(Parse *pParse, const char *zSql){
   db->pParse = pParse;
   while( 1 ){
     n = sqlite3GetToken((u8*)zSql, &tokenType);
+    if( lastTokenParsed==-1 && tokenType!=TK_SPACE
+     && pParse->nested==0 && db->init.busy==0
+    ){
+      /* Statements that begin with a DML keyword may allocate their
+      ** expression nodes from the parse arena, since no expression tree
+      ** built by such a statement outlives the parse.  DDL statements
+      ** hand trees to schema objects, so everything else stays on the
+      ** ordinary allocator.  Nested parses (sqlite3NestedParse() runs
+      ** DML text on behalf of an outer DDL statement) and schema-init
+      ** parses are excluded: their trees serve an outer statement or
+      ** the schema, the exact lifetimes the gate exists to keep off
+      ** the arena. */
+      switch( tokenType ){
+        case TK_SELECT:
+        case TK_WITH:
+        case TK_INSERT:
+        case TK_UPDATE:
+        case TK_DELETE:
+        case TK_REPLACE:
+        case TK_VALUES:
+          pParse->okArena = 1;
+          break;
+      }
+    }
     mxSqlLen -= n;
     if( mxSqlLen<0 ){
       pParse->rc = SQLITE_TOOBIG;
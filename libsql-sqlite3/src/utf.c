@@ -263,6 +263,21 @@ SQLITE_NOINLINE int sqlite3VdbeMemTranslate(Mem *pMem, u8 desiredEnc){
     if( desiredEnc==SQLITE_UTF16LE ){
       /* UTF-8 -> UTF-16 Little-endian */
       while( zIn<zTerm ){
+        /* Widen runs of ASCII eight bytes at a time.  A single wide
+        ** load classifies the run; each byte then expands to one
+        ** little-endian code unit. */
+        while( zTerm-zIn>=8 ){
+          u64 v;
+          int i;
+          memcpy(&v, zIn, 8);
+          if( v & 0x8080808080808080LL ) break;
+          for(i=0; i<8; i++){
+            *z++ = zIn[i];
+            *z++ = 0;
+          }
+          zIn += 8;
+        }
+        if( zIn>=zTerm ) break;
         READ_UTF8(zIn, zTerm, c);
         WRITE_UTF16LE(z, c);
       }
@@ -270,6 +285,18 @@ SQLITE_NOINLINE int sqlite3VdbeMemTranslate(Mem *pMem, u8 desiredEnc){
       assert( desiredEnc==SQLITE_UTF16BE );
       /* UTF-8 -> UTF-16 Big-endian */
       while( zIn<zTerm ){
+        while( zTerm-zIn>=8 ){
+          u64 v;
+          int i;
+          memcpy(&v, zIn, 8);
+          if( v & 0x8080808080808080LL ) break;
+          for(i=0; i<8; i++){
+            *z++ = 0;
+            *z++ = zIn[i];
+          }
+          zIn += 8;
+        }
+        if( zIn>=zTerm ) break;
         READ_UTF8(zIn, zTerm, c);
         WRITE_UTF16BE(z, c);
       }
@@ -281,6 +308,24 @@ SQLITE_NOINLINE int sqlite3VdbeMemTranslate(Mem *pMem, u8 desiredEnc){
     if( pMem->enc==SQLITE_UTF16LE ){
       /* UTF-16 Little-endian -> UTF-8 */
       while( zIn<zTerm ){
+        /* Narrow runs of ASCII code units eight bytes (four characters)
+        ** at a time: in little-endian order an ASCII-only word has the
+        ** form 00xx00xx00xx00xx.  The mask below maps memory bytes to
+        ** word positions assuming a little-endian host, so the fast
+        ** path is compiled out everywhere else. */
+#if SQLITE_BYTEORDER==1234
+        while( zTerm-zIn>=8 ){
+          u64 v;
+          memcpy(&v, zIn, 8);
+          if( v & 0xFF80FF80FF80FF80LL ) break;
+          *z++ = zIn[0];
+          *z++ = zIn[2];
+          *z++ = zIn[4];
+          *z++ = zIn[6];
+          zIn += 8;
+        }
+        if( zIn>=zTerm ) break;
+#endif
         c = *(zIn++);
         c += (*(zIn++))<<8;
         if( c>=0xd800 && c<0xe000 ){
@@ -310,6 +355,22 @@ SQLITE_NOINLINE int sqlite3VdbeMemTranslate(Mem *pMem, u8 desiredEnc){
     }else{
       /* UTF-16 Big-endian -> UTF-8 */
       while( zIn<zTerm ){
+        /* As above, but big-endian code units have the ASCII byte in
+        ** the odd positions: an ASCII-only word is xx00xx00 mirrored.
+        ** This mask too encodes a little-endian host byte order. */
+#if SQLITE_BYTEORDER==1234
+        while( zTerm-zIn>=8 ){
+          u64 v;
+          memcpy(&v, zIn, 8);
+          if( v & 0x80FF80FF80FF80FFLL ) break;
+          *z++ = zIn[1];
+          *z++ = zIn[3];
+          *z++ = zIn[5];
+          *z++ = zIn[7];
+          zIn += 8;
+        }
+        if( zIn>=zTerm ) break;
+#endif
         c = (*(zIn++))<<8;
         c += *(zIn++);
         if( c>=0xd800 && c<0xe000 ){
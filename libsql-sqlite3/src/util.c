@@ -394,6 +394,48 @@ int sqlite3_strnicmp(const char *zLeft, const char *zRight, int N){
   return N<0 ? 0 : UpperToLower[*a] - UpperToLower[*b];
 }
 
+/*
+** Case-insensitive comparison for the built-in NOCASE collation.  The
+** semantics are those of sqlite3_strnicmp() - the scan stops at the
+** first NUL in either string even when N is larger - but the caller
+** guarantees that BOTH buffers are at least N bytes long.  That
+** guarantee is what makes the eight-byte loads below safe; in
+** sqlite3_strnicmp() itself N is only an upper bound and may exceed
+** either allocation, so no such fast path is possible there.
+*/
+int sqlite3StrNICmpBounded(const char *zLeft, const char *zRight, int N){
+  register unsigned char *a, *b;
+  assert( zLeft!=0 || N<=0 );
+  assert( zRight!=0 || N<=0 );
+  a = (unsigned char *)zLeft;
+  b = (unsigned char *)zRight;
+  /* Skip equal (case-folded) prefixes eight bytes at a time.  The SWAR
+  ** fold lowercases exactly the bytes in 'A'..'Z', matching the
+  ** UpperToLower[] table, and bytes with the high bit set are never
+  ** folded.  Words containing a NUL (end of string) or any folded
+  ** difference fall through to the byte loop, which resolves ordering.
+  ** A NUL in zRight alone always folds unequal to the corresponding
+  ** byte of zLeft, so testing zLeft for NUL covers both strings. */
+  while( N>=8 ){
+    static const u64 ONES = 0x0101010101010101LL;
+    static const u64 HIGH = 0x8080808080808080LL;
+    u64 va, vb, wa, wb, ma, mb;
+    memcpy(&va, a, 8);
+    if( (va-ONES) & ~va & HIGH ) break;      /* contains a NUL */
+    memcpy(&vb, b, 8);
+    wa = va & ~HIGH;
+    wb = vb & ~HIGH;
+    ma = (wa+(0x80-0x41)*ONES) & ~(wa+(0x80-0x5B)*ONES) & ~va & HIGH;
+    mb = (wb+(0x80-0x41)*ONES) & ~(wb+(0x80-0x5B)*ONES) & ~vb & HIGH;
+    if( (va ^ (ma>>2)) != (vb ^ (mb>>2)) ) break;
+    a += 8;
+    b += 8;
+    N -= 8;
+  }
+  while( N-- > 0 && *a!=0 && UpperToLower[*a]==UpperToLower[*b]){ a++; b++; }
+  return N<0 ? 0 : UpperToLower[*a] - UpperToLower[*b];
+}
+
 /*
 ** Compute an 8-bit hash on a string that is insensitive to case differences
 */
@@ -788,7 +830,38 @@ int sqlite3Atoi64(const char *zNum, i64 *pNum, int length, u8 enc){
   }
   zStart = zNum;
   while( zNum<zEnd && zNum[0]=='0' ){ zNum+=incr; } /* Skip leading zeros. */
-  for(i=0; &zNum[i]<zEnd && (c=zNum[i])>='0' && c<='9'; i+=incr){
+  i = 0;
+  if( incr==1 ){
+    /* Consume digits eight at a time.  A single wide load both
+    ** validates that all eight bytes are digits (SWAR range check) and
+    ** supplies the bytes for a multiply-accumulate conversion, turning
+    ** the per-character loop below into one iteration per eight digits
+    ** for the long runs that CSV-sourced conversions are full of.
+    ** The i<=10 guard keeps the 8-digit strides from overshooting
+    ** where the scalar loop's u64 overflow behavior must take over.
+    ** The multiply-accumulate below pairs digits by their position in
+    ** the loaded word, which matches their position in the text only
+    ** on little-endian hosts, so the stride is compiled out elsewhere.
+    */
+#if SQLITE_BYTEORDER==1234
+    while( &zNum[i+8]<=zEnd && i<=10 ){
+      u64 v;
+      u64 t1, t2;
+      memcpy(&v, &zNum[i], 8);
+      t1 = v + 0x4646464646464646LL;          /* overflow if byte > 0x39 */
+      t2 = v - 0x3030303030303030LL;          /* borrow if byte < 0x30 */
+      if( (t1|t2) & 0x8080808080808080LL ) break;
+      /* Convert: pairs, then quads, then all eight digits */
+      v = t2;
+      v = (v*10 + (v>>8)) & 0x00FF00FF00FF00FFLL;
+      v = (v*100 + (v>>16)) & 0x0000FFFF0000FFFFLL;
+      v = ((v&0xFFFFFFFF)*10000 + (v>>32)) & 0xFFFFFFFF;
+      u = u*100000000 + v;
+      i += 8;
+    }
+#endif
+  }
+  for(; &zNum[i]<zEnd && (c=zNum[i])>='0' && c<='9'; i+=incr){
     u = u*10 + c - '0';
   }
   testcase( i==18*incr );
@@ -2231,6 +2231,7 @@ case OP_Ge: {             /* same as TK_GE, jump, in1, in3 */
   u16 flags1;         /* Copy of initial value of pIn1->flags */
   u16 flags3;         /* Copy of initial value of pIn3->flags */
 
+compare_op:
   pIn1 = &aMem[pOp->p1];
   pIn3 = &aMem[pOp->p3];
   flags1 = pIn1->flags;
@@ -2911,6 +2912,26 @@ case OP_Offset: {          /* out3 */
 ** typeof() function or the IS NULL or IS NOT NULL operators or the
 ** equivalent.  In this case, all content loading can be omitted.
 */
+/* Opcode: ColumnCmp P1 P2 P3 * *
+** Synopsis: r[P3]=PX(P1.P2); fused compare
+**
+** A superinstruction: exactly OP_Column, followed immediately by the
+** comparison opcode at the next address, executed without another trip
+** through the dispatcher.  Generated from eligible OP_Column/comparison
+** pairs by the prepare-time pass in vdbeaux.c when the library is built
+** with SQLITE_ENABLE_SUPERINSTRUCTIONS.  The comparison opcode remains
+** in place at the following address, so jumps that land on it directly
+** still behave normally.
+*/
+/* Opcode: ColumnAgg P1 P2 P3 * *
+** Synopsis: r[P3]=PX(P1.P2); fused agg step
+**
+** A superinstruction like OP_ColumnCmp, fusing OP_Column with the
+** OP_AggStep at the following address - the dominant pair in
+** aggregate scan loops.
+*/
+case OP_ColumnAgg:           /* ncycle */
+case OP_ColumnCmp:           /* ncycle */
 case OP_Column: {            /* ncycle */
   u32 p2;            /* column number to retrieve */
   VdbeCursor *pC;    /* The VDBE cursor */
@@ -2989,7 +3010,22 @@ op_column_restart:
     }else{
       pC->iHdrOffset = sqlite3GetVarint32(pC->aRow, aOffset);
     }
-    pC->nHdrParsed = 0;
+    if( pC->nHdrSave>0
+     && pC->szRow>=pC->nHdrSave
+     && memcmp(pC->aRow, pC->aHdrSave, pC->nHdrSave)==0
+    ){
+      /* The new row begins with the same header bytes as the previous
+      ** row (the saved prefix includes the header-size varint), so the
+      ** aType[] and aOffset[] entries computed for the previous row are
+      ** valid for this row as well.  Common for tables whose rows all
+      ** use the same serial types, where this replaces a varint walk
+      ** over the whole header with one memcmp. */
+      pC->nHdrParsed = pC->nHdrParsedSave;
+      pC->iHdrOffset = pC->nHdrSave;
+    }else{
+      pC->nHdrParsed = 0;
+      pC->nHdrSave = 0;
+    }
 
     if( pC->szRow<aOffset[0] ){      /*OPTIMIZATION-IF-FALSE*/
       /* pC->aRow does not have to hold the entire row, but it does at least
@@ -3025,10 +3061,13 @@ op_column_restart:
       ** this overread is harmless.  Similar overreads can occur for a corrupt
       ** database file.
       */
-      zData = pC->aRow;
-      assert( pC->nHdrParsed<=p2 );         /* Conditional skipped */
-      testcase( aOffset[0]==0 );
-      goto op_column_read_header;
+      if( pC->nHdrParsed<=p2 && pC->iHdrOffset<aOffset[0] ){
+        zData = pC->aRow;
+        goto op_column_read_header;
+      }
+      /* Either the restored header prefix already covers p2, or the
+      ** whole header has been parsed and column p2 is beyond it; both
+      ** cases are handled by the general path below. */
     }
   }else if( sqlite3BtreeCursorHasMoved(pC->uc.pCursor) ){
     rc = sqlite3VdbeHandleMovedCursor(pC);
@@ -3092,6 +3131,16 @@ op_column_restart:
 
       pC->nHdrParsed = i;
       pC->iHdrOffset = (u32)(zHdr - zData);
+      if( pC->aRow!=0 && pC->iHdrOffset<=sizeof(pC->aHdrSave) ){
+        /* Save the parsed header prefix so that the next row can reuse
+        ** the aType[]/aOffset[] entries if its header starts with the
+        ** same bytes. */
+        memcpy(pC->aHdrSave, pC->aRow, pC->iHdrOffset);
+        pC->nHdrSave = (u16)pC->iHdrOffset;
+        pC->nHdrParsedSave = (u16)pC->nHdrParsed;
+      }else{
+        pC->nHdrSave = 0;
+      }
       if( pC->aRow==0 ) sqlite3VdbeMemRelease(&sMem);
     }else{
       t = 0;
@@ -3194,6 +3243,22 @@ op_column_restart:
 op_column_out:
   UPDATE_MAX_BLOBSIZE(pDest);
   REGISTER_TRACE(pOp->p3, pDest);
+  if( pOp->opcode==OP_ColumnCmp ){
+    /* Superinstruction: enter the following comparison opcode directly */
+    pOp++;
+    assert( pOp->opcode==OP_Eq || pOp->opcode==OP_Ne || pOp->opcode==OP_Lt
+         || pOp->opcode==OP_Le || pOp->opcode==OP_Gt || pOp->opcode==OP_Ge );
+    goto compare_op;
+  }
+  if( pOp->opcode==OP_ColumnAgg ){
+    /* Superinstruction: enter the following aggregate step directly.
+    ** The target opcode rewrites itself from AggStep to AggStep1 after
+    ** its first execution, so pick the matching entry point. */
+    pOp++;
+    if( pOp->opcode==OP_AggStep1 ) goto agg_step_one;
+    assert( pOp->opcode==OP_AggStep );
+    goto agg_step_zero;
+  }
   break;
 
 op_column_corrupt:
@@ -7686,6 +7751,7 @@ case OP_AggStep: {
   int n;
   sqlite3_context *pCtx;
 
+agg_step_zero:
   assert( pOp->p4type==P4_FUNCDEF );
   n = pOp->p5;
   assert( pOp->p3>0 && pOp->p3<=(p->nMem+1 - p->nCursor) );
@@ -7719,6 +7785,7 @@ case OP_AggStep1: {
   sqlite3_context *pCtx;
   Mem *pMem;
 
+agg_step_one:
   assert( pOp->p4type==P4_FUNCCTX );
   pCtx = pOp->p4.pCtx;
   pMem = &aMem[pOp->p3];
@@ -108,6 +108,8 @@ struct VdbeCursor {
   /* seekResult does not distinguish between "no seeks have ever occurred
   ** on this cursor" and "the most recent seek was an exact match".
   ** For CURTYPE_PSEUDO, seekResult is the register holding the record */
+  u16 nHdrSave;           /* Valid bytes in aHdrSave[], or 0 if invalid */
+  u16 nHdrParsedSave;     /* Value of nHdrParsed covered by aHdrSave[] */
 
   /* When a new VdbeCursor is allocated, only the fields above are zeroed.
   ** The fields that follow are uninitialized, and must be individually
@@ -132,6 +134,10 @@ struct VdbeCursor {
   u64 maskUsed;           /* Mask of columns used by this cursor */
 #endif
   VdbeTxtBlbCache *pCache; /* Cache of large TEXT or BLOB values */
+  u8 aHdrSave[128];       /* Copy of the parsed record header prefix of the
+                          ** previous row.  If the next row starts with the
+                          ** same bytes, aType[]/aOffset[] are still valid
+                          ** and OP_Column skips re-parsing the header. */
 
   /* 2*nField extra array elements allocated for aType[], beyond the one
   ** static element declared in the structure.  nField total array slots for
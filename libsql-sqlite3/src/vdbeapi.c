@@ -1351,6 +1351,70 @@ const void *sqlite3_column_blob(sqlite3_stmt *pStmt, int i){
   columnMallocFailure(pStmt);
   return val;
 }
+
+/*
+** libsql extension: zero-copy access to BLOB/TEXT column content.  See
+** the API documentation in sqlite.h.in.  No conversion or expansion is
+** performed; values whose content is not already materialized as a
+** contiguous byte array yield NULL.
+*/
+const void *libsql_column_blob_pinned(sqlite3_stmt *pStmt, int i, int *pnBytes){
+  Mem *p = columnMem(pStmt, i);
+  const void *pRet = 0;
+  if( pnBytes ) *pnBytes = 0;
+  if( p && (p->flags & (MEM_Blob|MEM_Str))!=0 && (p->flags & MEM_Zero)==0 ){
+    pRet = p->z;
+    if( pnBytes ) *pnBytes = p->n;
+  }
+  columnMallocFailure(pStmt);
+  return pRet;
+}
+
+/*
+** libsql extension: execute a prepared statement nIter times inside a
+** single mutex acquisition.  Before each iteration the statement is
+** reset and xBind (if not NULL) is invoked to bind that iteration's
+** parameters; the iteration then runs to completion, discarding any
+** rows.  Execution stops at the first error and the failing iteration
+** can be recovered from the return value of sqlite3_errcode().
+**
+** This amortizes the per-call costs of sqlite3_step() - the mutex
+** round trips and API housekeeping - across the whole batch, which is
+** what dominates tight single-row INSERT loops.  It does not start a
+** transaction: callers ingesting in bulk should still wrap the batch
+** in BEGIN...COMMIT (or rely on a single multi-row statement) so that
+** each iteration does not pay a commit.
+*/
+int libsql_stmt_exec_batch(
+  sqlite3_stmt *pStmt,            /* Prepared statement to run */
+  int nIter,                      /* Number of iterations */
+  int (*xBind)(void*,sqlite3_stmt*,int),  /* Bind parameters, or NULL */
+  void *pArg                      /* First argument to xBind */
+){
+  Vdbe *v = (Vdbe*)pStmt;
+  sqlite3 *db;
+  int rc = SQLITE_OK;
+  int i;
+  if( vdbeSafetyNotNull(v) ){
+    return SQLITE_MISUSE_BKPT;
+  }
+  db = v->db;
+  sqlite3_mutex_enter(db->mutex);
+  for(i=0; i<nIter && rc==SQLITE_OK; i++){
+    sqlite3_reset(pStmt);
+    if( xBind ){
+      rc = xBind(pArg, pStmt, i);
+      if( rc!=SQLITE_OK ) break;
+    }
+    do{
+      rc = sqlite3_step(pStmt);
+    }while( rc==SQLITE_ROW );
+    if( rc==SQLITE_DONE ) rc = SQLITE_OK;
+  }
+  sqlite3_reset(pStmt);
+  sqlite3_mutex_leave(db->mutex);
+  return rc;
+}
 int sqlite3_column_bytes(sqlite3_stmt *pStmt, int i){
   int val = sqlite3_value_bytes( columnMem(pStmt,i) );
   columnMallocFailure(pStmt);
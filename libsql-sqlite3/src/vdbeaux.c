@@ -2607,6 +2607,38 @@ void sqlite3VdbeRewind(Vdbe *p){
 ** Use the sqlite3VdbeRewind() procedure to restore a virtual machine back
 ** to its initial state after it has been run.
 */
+#ifdef SQLITE_ENABLE_SUPERINSTRUCTIONS
+/*
+** Rewrite eligible opcode pairs into superinstructions so that the
+** second opcode of the pair is entered by falling out of the first,
+** without another trip through the sqlite3VdbeExec() dispatcher.
+**
+** Two fusions are performed: OP_Column followed by one of the six
+** comparison opcodes becomes OP_ColumnCmp (the dominant pair in
+** filter-scan loops), and OP_Column followed by OP_AggStep becomes
+** OP_ColumnAgg (the dominant pair in aggregate scans).  The rewrites
+** are unconditionally safe: the second opcode stays at its own address
+** with unchanged operands, so a jump that lands on it executes it
+** standalone exactly as before.
+*/
+static void vdbeFuseSuperinstructions(Vdbe *p){
+  int i;
+  Op *aOp = p->aOp;
+  for(i=0; i<p->nOp-1; i++){
+    if( aOp[i].opcode==OP_Column ){
+      u8 op2 = aOp[i+1].opcode;
+      if( op2==OP_Eq || op2==OP_Ne || op2==OP_Lt
+       || op2==OP_Le || op2==OP_Gt || op2==OP_Ge
+      ){
+        aOp[i].opcode = OP_ColumnCmp;
+      }else if( op2==OP_AggStep && aOp[i+1].p1==0 ){
+        aOp[i].opcode = OP_ColumnAgg;
+      }
+    }
+  }
+}
+#endif /* SQLITE_ENABLE_SUPERINSTRUCTIONS */
+
 void sqlite3VdbeMakeReady(
   Vdbe *p,                       /* The VDBE */
   Parse *pParse                  /* Parsing context */
@@ -2699,6 +2731,9 @@ void sqlite3VdbeMakeReady(
     initMemArray(p->aMem, nMem, db, MEM_Undefined);
     memset(p->apCsr, 0, nCursor*sizeof(VdbeCursor*));
   }
+#ifdef SQLITE_ENABLE_SUPERINSTRUCTIONS
+  vdbeFuseSuperinstructions(p);
+#endif
   sqlite3VdbeRewind(p);
 }
 
@@ -5058,6 +5093,80 @@ vrcs_restart:
   return res;
 }
 
+/*
+** This works like vdbeRecordCompareString() but for the case where the
+** first field of pPKey2 is a BLOB - the hot shape for databases keyed
+** by UUIDs or other fixed-width binary identifiers.  Blobs sort after
+** every other storage class, compare by memcmp, and never involve a
+** collating function, so the whole comparison runs without decoding
+** the rest of either header.
+*/
+static int vdbeRecordCompareBlob(
+  int nKey1, const void *pKey1, /* Left key */
+  UnpackedRecord *pPKey2        /* Right key */
+){
+  const u8 *aKey1 = (const u8*)pKey1;
+  int serial_type;
+  int res;
+
+  assert( pPKey2->aMem[0].flags & MEM_Blob );
+  assert( !(pPKey2->aMem[0].flags & MEM_Zero) );
+  assert( pPKey2->aMem[0].n == pPKey2->n );
+  assert( pPKey2->aMem[0].z == pPKey2->u.z );
+  vdbeAssertFieldCountWithinLimits(nKey1, pKey1, pPKey2->pKeyInfo);
+  serial_type = (signed char)(aKey1[1]);
+
+vrcb_restart:
+  if( serial_type<12 ){
+    if( serial_type<0 ){
+      sqlite3GetVarint32(&aKey1[1], (u32*)&serial_type);
+      if( serial_type>=12 ) goto vrcb_restart;
+      assert( CORRUPT_DB );
+    }
+    res = pPKey2->r1;      /* (pKey1/nKey1) is a number or a null */
+  }else if( serial_type & 0x01 ){
+    res = pPKey2->r1;      /* (pKey1/nKey1) is text; blobs sort after */
+  }else{
+    int nCmp;
+    int nBlob;
+    int szHdr = aKey1[0];
+
+    nBlob = (serial_type-12) / 2;
+    if( (szHdr + nBlob) > nKey1 ){
+      pPKey2->errCode = (u8)SQLITE_CORRUPT_BKPT;
+      return 0;    /* Corruption */
+    }
+    nCmp = MIN( pPKey2->n, nBlob );
+    res = memcmp(&aKey1[szHdr], pPKey2->u.z, nCmp);
+
+    if( res>0 ){
+      res = pPKey2->r2;
+    }else if( res<0 ){
+      res = pPKey2->r1;
+    }else{
+      res = nBlob - pPKey2->n;
+      if( res==0 ){
+        if( pPKey2->nField>1 ){
+          res = sqlite3VdbeRecordCompareWithSkip(nKey1, pKey1, pPKey2, 1);
+        }else{
+          res = pPKey2->default_rc;
+          pPKey2->eqSeen = 1;
+        }
+      }else if( res>0 ){
+        res = pPKey2->r2;
+      }else{
+        res = pPKey2->r1;
+      }
+    }
+  }
+
+  assert( vdbeRecordCompareDebug(nKey1, pKey1, pPKey2, res)
+       || CORRUPT_DB
+       || pPKey2->pKeyInfo->db->mallocFailed
+  );
+  return res;
+}
+
 /*
 ** Return a pointer to an sqlite3VdbeRecordCompare() compatible function
 ** suitable for comparing serialized records to the unpacked record passed
@@ -5104,6 +5213,14 @@ RecordCompare sqlite3VdbeFindCompare(UnpackedRecord *p){
       p->n = p->aMem[0].n;
       return vdbeRecordCompareString;
     }
+    if( (flags & (MEM_Real|MEM_IntReal|MEM_Null|MEM_Str|MEM_Zero))==0
+     && (flags & MEM_Blob)!=0
+    ){
+      /* Fixed-width binary keys (UUIDs and the like) */
+      p->u.z = p->aMem[0].z;
+      p->n = p->aMem[0].n;
+      return vdbeRecordCompareBlob;
+    }
   }
 
   return sqlite3VdbeRecordCompare;
@@ -860,18 +860,28 @@ static int vdbeSorterCompareInt(
   assert( (s2>0 && s2<7) || s2==8 || s2==9 );
 
   if( s1==s2 ){
-    /* The two values have the same sign. Compare using memcmp(). */
+    /* The two values have the same serial type.  Decode both into i64s
+    ** with one wide load each and compare directly: the payload bytes
+    ** are big-endian two's complement, so after sign extension a native
+    ** integer compare gives the answer without the byte-at-a-time loop
+    ** (and without the sign fix-up it needed on a differing top byte). */
     static const u8 aLen[] = {0, 1, 2, 3, 4, 6, 8, 0, 0, 0 };
     const u8 n = aLen[s1];
-    int i;
-    res = 0;
-    for(i=0; i<n; i++){
-      if( (res = v1[i] - v2[i])!=0 ){
-        if( ((v1[0] ^ v2[0]) & 0x80)!=0 ){
-          res = v1[0] & 0x80 ? -1 : +1;
-        }
-        break;
+    if( n==0 ){
+      /* Serial types 8 and 9: constants 0 and 1, always equal here */
+      res = 0;
+    }else{
+      u64 x1 = 0, x2 = 0;
+      int i;
+      for(i=0; i<n; i++){
+        x1 = (x1<<8) | v1[i];
+        x2 = (x2<<8) | v2[i];
       }
+      /* Flipping the sign bit maps two's complement order onto unsigned
+      ** order, avoiding an implementation-defined signed shift. */
+      x1 ^= (u64)1 << (n*8-1);
+      x2 ^= (u64)1 << (n*8-1);
+      res = (x1>x2) - (x1<x2);
     }
   }else if( s1>7 && s2>7 ){
     res = s1 - s2;
@@ -273,6 +273,7 @@ static int sqlite3WalCheckpoint(
 );
 static void sqlite3WalEndReadTransaction(Wal *pWal);
 static int sqlite3WalEndWriteTransaction(Wal *pWal);
+static void walGroupDetach(Wal *pWal);
 static int walFindFrame(
   Wal *pWal,                      /* WAL handle */
   Pgno pgno,                      /* Database page number to read data for */
@@ -305,6 +306,10 @@ int sqlite3WalTrace = 0;
 */
 #define WAL_MAX_VERSION      3007000
 #define WALINDEX_MAX_VERSION 3007000
+/* wal-index version advertised for compressed WALs, so that library
+** versions without compression support fail with SQLITE_CANTOPEN
+** instead of misreading frames */
+#define WALINDEX_CMP_VERSION 3007001
 
 /*
 ** Index numbers for various locking bytes.   WAL_NREADER is the number
@@ -485,6 +490,12 @@ struct WalCkptInfo {
 */
 #define WAL_MAGIC 0x377f0682
 
+/* Magic value for WAL files whose frame content is compressed (see
+** SQLITE_ENABLE_WAL_COMPRESSION).  The least significant bit still
+** selects big-endian checksums, as for WAL_MAGIC.  Readers built
+** without compression support refuse such files. */
+#define WAL_CMAGIC 0x377f0684
+
 /*
 ** Return the offset of frame iFrame in the write-ahead log file,
 ** assuming a database page size of szPage bytes. The offset returned
@@ -494,6 +505,22 @@ struct WalCkptInfo {
   WAL_HDRSIZE + ((iFrame)-1)*(i64)((szPage)+WAL_FRAME_HDRSIZE)         \
 )
 
+/*
+** In a compressed WAL, the content area of each frame is 8 bytes larger
+** than the page size: an 8-byte prefix holds the compressed payload
+** length (0 meaning "stored uncompressed"), followed by the payload,
+** zero-padded to a multiple of 8 so the cumulative checksums stay
+** deterministic.  Frame slots remain fixed-size; only the bytes
+** actually written shrink.  These variants of the sizing macros are
+** used wherever a Wal handle is available.
+*/
+#define walFrameContentSz(pWal, szPage) \
+  ((szPage) + ((pWal)->bCompress ? 8 : 0))
+#define walFrameSz(pWal, szPage) \
+  (walFrameContentSz(pWal,szPage) + WAL_FRAME_HDRSIZE)
+#define walFrameOffsetW(pWal, iFrame, szPage) ( \
+  WAL_HDRSIZE + ((iFrame)-1)*(i64)walFrameSz(pWal, szPage) )
+
 /*
 ** Candidate values for Wal.exclusiveMode.
 */
@@ -805,7 +832,8 @@ static SQLITE_NO_TSAN void walIndexWriteHdr(Wal *pWal){
 
   assert( pWal->writeLock );
   pWal->hdr.isInit = 1;
-  pWal->hdr.iVersion = WALINDEX_MAX_VERSION;
+  pWal->hdr.iVersion = pWal->bCompress ? WALINDEX_CMP_VERSION
+                                       : WALINDEX_MAX_VERSION;
   walChecksumBytes(1, (u8*)&pWal->hdr, nCksum, 0, pWal->hdr.aCksum);
   /* Possible TSAN false-positive.  See tag-20200519-1 */
   memcpy((void*)&aHdr[1], (const void*)&pWal->hdr, sizeof(WalIndexHdr));
@@ -813,6 +841,137 @@ static SQLITE_NO_TSAN void walIndexWriteHdr(Wal *pWal){
   memcpy((void*)&aHdr[0], (const void*)&pWal->hdr, sizeof(WalIndexHdr));
 }
 
+
+#ifdef SQLITE_ENABLE_WAL_COMPRESSION
+#include <zlib.h>
+
+/* Make sure the compression scratch buffer is allocated */
+static int walCmpBuf(Wal *pWal){
+  if( pWal->aCmpBuf==0 ){
+    /* Payload area (szPage+16) followed by a page-sized decompression
+    ** area for partial-page reads */
+    pWal->aCmpBuf = (u8*)sqlite3_malloc64(2*(u64)pWal->szPage+32);
+  }
+  return pWal->aCmpBuf ? SQLITE_OK : SQLITE_NOMEM_BKPT;
+}
+#endif /* SQLITE_ENABLE_WAL_COMPRESSION */
+
+/*
+** Produce the on-disk content image for page data aData.  For ordinary
+** WALs this is the page itself.  For compressed WALs the image is built
+** in pWal->aCmpBuf: length prefix, deflate payload (or the stored page
+** when compression does not help), zero padding to a multiple of 8.
+*/
+static int walFrameContent(
+  Wal *pWal,                      /* Write-ahead log */
+  const u8 *aData,                /* Page content */
+  const u8 **paOut,               /* OUT: image to write */
+  int *pnOut                      /* OUT: number of bytes in image */
+){
+  if( !pWal->bCompress ){
+    *paOut = aData;
+    *pnOut = pWal->szPage;
+    return SQLITE_OK;
+  }
+#ifdef SQLITE_ENABLE_WAL_COMPRESSION
+  {
+    uLongf nComp = pWal->szPage;
+    int nPayload;
+    u8 *aOut;
+    int rc = walCmpBuf(pWal);
+    if( rc ) return rc;
+    aOut = pWal->aCmpBuf;
+    if( compress2(&aOut[8], &nComp, aData, pWal->szPage, 1)!=Z_OK
+     || nComp>=(uLongf)pWal->szPage
+    ){
+      memcpy(&aOut[8], aData, pWal->szPage);
+      nComp = 0;                  /* Zero means stored uncompressed */
+    }
+    sqlite3Put4byte(aOut, (u32)nComp);
+    sqlite3Put4byte(&aOut[4], 0);
+    nPayload = nComp ? (int)nComp : pWal->szPage;
+    while( nPayload&7 ){ aOut[8+nPayload] = 0; nPayload++; }
+    *paOut = aOut;
+    *pnOut = 8 + nPayload;
+    return SQLITE_OK;
+  }
+#else
+  return SQLITE_MISUSE_BKPT;      /* bCompress is never set */
+#endif
+}
+
+/*
+** Given the raw stored content area of a frame, determine how many of
+** its bytes are covered by the frame checksum.  Returns non-zero if the
+** length prefix is out of range (a corrupt frame).
+*/
+static int walFrameContentLen(Wal *pWal, const u8 *aContent, int *pnOut){
+  if( !pWal->bCompress ){
+    *pnOut = pWal->szPage;
+  }else{
+    u32 nComp = sqlite3Get4byte(aContent);
+    if( nComp>(u32)pWal->szPage ) return 1;
+    *pnOut = 8 + (int)ROUND8( nComp ? nComp : (u32)pWal->szPage );
+  }
+  return 0;
+}
+
+/*
+** Read the content of frame iRead into pOut (up to nOut bytes of page
+** data), decompressing if the WAL is compressed.  aScratch must point
+** to at least szPage+16 bytes when the WAL is compressed and the caller
+** may be running on a thread of its own (the parallel checkpoint
+** workers); serial callers pass NULL and the Wal's own scratch is used.
+*/
+static int walReadFrameContent(
+  Wal *pWal,                      /* Write-ahead log */
+  u32 iRead,                      /* Frame to read */
+  int szPage,                     /* Page size */
+  u8 *pOut,                       /* OUT: page content */
+  int nOut,                       /* Size of pOut */
+  u8 *aScratch                    /* Scratch for decompression, or NULL */
+){
+  i64 iOffset = walFrameOffsetW(pWal, iRead, szPage) + WAL_FRAME_HDRSIZE;
+  if( !pWal->bCompress ){
+    return sqlite3OsRead(pWal->pWalFd, pOut, (nOut>szPage ? szPage : nOut),
+                         iOffset);
+  }
+#ifdef SQLITE_ENABLE_WAL_COMPRESSION
+  {
+    u8 aPrefix[8];
+    u32 nComp;
+    int rc = sqlite3OsRead(pWal->pWalFd, aPrefix, 8, iOffset);
+    if( rc ) return rc;
+    nComp = sqlite3Get4byte(aPrefix);
+    if( nComp==0 ){
+      return sqlite3OsRead(pWal->pWalFd, pOut,
+                           (nOut>szPage ? szPage : nOut), iOffset+8);
+    }
+    if( nComp>(u32)szPage ) return SQLITE_CORRUPT_BKPT;
+    if( aScratch==0 ){
+      rc = walCmpBuf(pWal);
+      if( rc ) return rc;
+      aScratch = pWal->aCmpBuf;
+    }
+    rc = sqlite3OsRead(pWal->pWalFd, aScratch, (int)nComp, iOffset+8);
+    if( rc ) return rc;
+    {
+      uLongf nExp = szPage;
+      u8 *aDest = (nOut>=szPage) ? pOut : &aScratch[szPage+16];
+      if( uncompress(aDest, &nExp, aScratch, nComp)!=Z_OK
+       || nExp!=(uLongf)szPage
+      ){
+        return SQLITE_CORRUPT_BKPT;
+      }
+      if( aDest!=pOut ) memcpy(pOut, aDest, nOut);
+    }
+    return SQLITE_OK;
+  }
+#else
+  return SQLITE_MISUSE_BKPT;      /* bCompress is never set */
+#endif
+}
+
 /*
 ** This function encodes a single frame header and writes it to a buffer
 ** supplied by the caller. A frame-header is made up of a series of
@@ -830,7 +989,8 @@ static void walEncodeFrame(
   Wal *pWal,                      /* The write-ahead log */
   u32 iPage,                      /* Database page number for frame */
   u32 nTruncate,                  /* New db size (or 0 for non-commit frames) */
-  u8 *aData,                      /* Pointer to page data */
+  const u8 *aData,                /* Pointer to the on-disk content image */
+  int nData,                      /* Number of bytes in aData */
   u8 *aFrame                      /* OUT: Write encoded frame here */
 ){
   int nativeCksum;                /* True for native byte-order checksums */
@@ -843,7 +1003,7 @@ static void walEncodeFrame(
 
     nativeCksum = (pWal->hdr.bigEndCksum==SQLITE_BIGENDIAN);
     walChecksumBytes(nativeCksum, aFrame, 8, aCksum, aCksum);
-    walChecksumBytes(nativeCksum, aData, pWal->szPage, aCksum, aCksum);
+    walChecksumBytes(nativeCksum, (u8*)aData, nData, aCksum, aCksum);
 
     sqlite3Put4byte(&aFrame[16], aCksum[0]);
     sqlite3Put4byte(&aFrame[20], aCksum[1]);
@@ -867,6 +1027,7 @@ static int walDecodeFrame(
   int nativeCksum;                /* True for native byte-order checksums */
   u32 *aCksum = pWal->hdr.aFrameCksum;
   u32 pgno;                       /* Page number of the frame */
+  int nData;                      /* Bytes of aData covered by the checksum */
   assert( WAL_FRAME_HDRSIZE==24 );
 
   /* A frame is only valid if the salt values in the frame-header
@@ -883,14 +1044,18 @@ static int walDecodeFrame(
     return 0;
   }
 
-  /* A frame is only valid if a checksum of the WAL header,
+  /* A frame is only valid if its content length prefix is sane
+  ** (compressed WALs only) and if a checksum of the WAL header,
   ** all prior frames, the first 16 bytes of this frame-header,
   ** and the frame-data matches the checksum in the last 8
   ** bytes of this frame-header.
   */
+  if( walFrameContentLen(pWal, aData, &nData) ){
+    return 0;
+  }
   nativeCksum = (pWal->hdr.bigEndCksum==SQLITE_BIGENDIAN);
   walChecksumBytes(nativeCksum, aFrame, 8, aCksum, aCksum);
-  walChecksumBytes(nativeCksum, aData, pWal->szPage, aCksum, aCksum);
+  walChecksumBytes(nativeCksum, aData, nData, aCksum, aCksum);
   if( aCksum[0]!=sqlite3Get4byte(&aFrame[16])
    || aCksum[1]!=sqlite3Get4byte(&aFrame[20])
   ){
@@ -1291,8 +1456,22 @@ static int walIndexRecover(Wal *pWal){
     */
     magic = sqlite3Get4byte(&aBuf[0]);
     szPage = sqlite3Get4byte(&aBuf[8]);
-    if( (magic&0xFFFFFFFE)!=WAL_MAGIC
-     || szPage&(szPage-1)
+    if( (magic&0xFFFFFFFE)==WAL_MAGIC ){
+      pWal->bCompress = 0;
+    }else if( (magic&0xFFFFFFFE)==WAL_CMAGIC ){
+#ifdef SQLITE_ENABLE_WAL_COMPRESSION
+      pWal->bCompress = 1;
+#else
+      /* A compressed WAL must never be mistaken for an empty one: that
+      ** would silently present the database without its committed WAL
+      ** content and eventually reset the WAL.  Refuse to open instead. */
+      rc = SQLITE_CANTOPEN_BKPT;
+      goto finished;
+#endif
+    }else{
+      goto finished;
+    }
+    if( szPage&(szPage-1)
      || szPage>SQLITE_MAX_PAGE_SIZE
      || szPage<512
     ){
@@ -1322,7 +1501,7 @@ static int walIndexRecover(Wal *pWal){
     }
 
     /* Malloc a buffer to read frames into. */
-    szFrame = szPage + WAL_FRAME_HDRSIZE;
+    szFrame = walFrameSz(pWal, szPage);
     aFrame = (u8 *)sqlite3_malloc64(szFrame + WALINDEX_PGSZ);
     SEH_FREE_ON_ERROR(0, aFrame);
     if( !aFrame ){
@@ -1347,7 +1526,7 @@ static int walIndexRecover(Wal *pWal){
       pWal->apWiData[iPg] = aPrivate;
 
       for(iFrame=iFirst; iFrame<=iLast; iFrame++){
-        i64 iOffset = walFrameOffset(iFrame, szPage);
+        i64 iOffset = walFrameOffsetW(pWal, iFrame, szPage);
         u32 pgno;                 /* Database page number for frame */
         u32 nTruncate;            /* dbsize field from frame header */
 
@@ -2001,6 +2180,143 @@ static void walRestartHdr(Wal *pWal, u32 salt1){
 ** checkpoint is running (in any other thread or process) at the same
 ** time.
 */
+
+#if SQLITE_MAX_WORKER_THREADS>0
+/* Minimum number of frames each checkpoint worker must have to make
+** spawning a thread worthwhile. */
+#define WALCKPT_MIN_FRAMES_PER_WORKER 32
+
+/*
+** Context for one checkpoint backfill worker.  Each worker owns a
+** disjoint slice of the (page, frame) pair array, so the workers write
+** to disjoint regions of the database file and no locking is needed:
+** pread/pwrite on the shared file descriptors are thread-safe.
+*/
+typedef struct WalCkptWorker WalCkptWorker;
+struct WalCkptWorker {
+  Wal *pWal;                      /* WAL being checkpointed */
+  const u32 *aPair;               /* This worker's (iDbpage, iFrame) pairs */
+  int nPair;                      /* Number of pairs in the slice */
+  int szPage;                     /* Database page size */
+  int rc;                         /* Result code out */
+};
+
+/* Thread main routine: copy each frame in the slice into the database */
+static void *walCkptCopyThread(void *pArg){
+  WalCkptWorker *p = (WalCkptWorker*)pArg;
+  u8 *aBuf = (u8*)sqlite3_malloc64(3*(u64)p->szPage+32);
+  int rc = SQLITE_OK;
+  int i;
+  if( aBuf==0 ) rc = SQLITE_NOMEM_BKPT;
+  for(i=0; rc==SQLITE_OK && i<p->nPair; i++){
+    u32 iDbpage = p->aPair[i*2];
+    u32 iFrame = p->aPair[i*2+1];
+    i64 iOffset;
+    rc = walReadFrameContent(p->pWal, iFrame, p->szPage, aBuf, p->szPage,
+                             &aBuf[p->szPage]);
+    if( rc==SQLITE_OK ){
+      iOffset = (iDbpage-1)*(i64)p->szPage;
+      rc = sqlite3OsWrite(p->pWal->pDbFd, aBuf, p->szPage, iOffset);
+    }
+  }
+  sqlite3_free(aBuf);
+  p->rc = rc;
+  return SQLITE_INT_TO_PTR(rc);
+}
+
+/*
+** Multi-threaded backfill (PRAGMA checkpoint_workers).  Drains pIter
+** into an array of (page, frame) pairs, partitions the array between
+** db->nCkptWorker workers - each page number appears exactly once, so
+** the partitions are disjoint by page - and copies the slices to the
+** database file in parallel.  All workers are joined before returning,
+** so the caller's wal-index header update happens after a full barrier.
+**
+** Returns true if it performed (or definitively failed) the backfill,
+** with *pRc set.  Returns false to let the caller run the ordinary
+** single-threaded loop instead (small checkpoint, OOM, interrupt).
+*/
+static int walCheckpointParallel(
+  Wal *pWal,                      /* Wal connection */
+  sqlite3 *db,                    /* Check for interrupts on this handle */
+  struct WalIteratorRev *pIter,   /* Frames to copy */
+  u32 nBackfill,                  /* Frames already backfilled */
+  u32 mxSafeFrame,                /* Last frame safe to copy */
+  u32 mxPage,                     /* Max database page to write */
+  int szPage,                     /* Database page size */
+  int *pRc                        /* OUT: result code */
+){
+  u32 iDbpage = 0;                /* Next database page to write */
+  u32 iFrame = 0;                 /* Wal frame containing data for iDbpage */
+  u32 *aPair;                     /* Array of (iDbpage, iFrame) pairs */
+  i64 nAlloc;                     /* Allocated size of aPair, in pairs */
+  int nPair = 0;                  /* Valid entries in aPair */
+  int nWorker;                    /* Number of workers to use */
+  int iBase = 0;                  /* First pair of the next slice */
+  int i;                          /* Loop counter */
+  int rc = SQLITE_OK;             /* Return code */
+  WalCkptWorker aWorker[SQLITE_MAX_WORKER_THREADS];
+  SQLiteThread *apThread[SQLITE_MAX_WORKER_THREADS];
+
+  nWorker = db->nCkptWorker;
+  if( nWorker>SQLITE_MAX_WORKER_THREADS ) nWorker = SQLITE_MAX_WORKER_THREADS;
+  nAlloc = (i64)mxSafeFrame - nBackfill;
+  assert( nWorker>1 && nAlloc>0 );
+  if( nAlloc < (i64)nWorker*WALCKPT_MIN_FRAMES_PER_WORKER ) return 0;
+  aPair = (u32*)sqlite3_malloc64(nAlloc*2*sizeof(u32));
+  if( aPair==0 ) return 0;
+
+  while( 0==walIteratorRevNext(pIter, &iDbpage, &iFrame) ){
+    if( iFrame<=nBackfill || iFrame>mxSafeFrame || iDbpage>mxPage ) continue;
+    if( AtomicLoad(&db->u1.isInterrupted) ){
+      *pRc = db->mallocFailed ? SQLITE_NOMEM_BKPT : SQLITE_INTERRUPT;
+      sqlite3_free(aPair);
+      return 1;
+    }
+    assert( nPair<nAlloc );
+    aPair[nPair*2] = iDbpage;
+    aPair[nPair*2+1] = iFrame;
+    nPair++;
+  }
+  if( nPair<nWorker*WALCKPT_MIN_FRAMES_PER_WORKER ){
+    nWorker = 1 + nPair/WALCKPT_MIN_FRAMES_PER_WORKER;
+  }
+
+  for(i=0; i<nWorker; i++){
+    int nSlice = nPair/nWorker + (i < nPair%nWorker);
+    aWorker[i].pWal = pWal;
+    aWorker[i].aPair = &aPair[iBase*2];
+    aWorker[i].nPair = nSlice;
+    aWorker[i].szPage = szPage;
+    aWorker[i].rc = SQLITE_OK;
+    iBase += nSlice;
+    if( i<nWorker-1 ){
+      if( sqlite3ThreadCreate(&apThread[i], walCkptCopyThread, &aWorker[i]) ){
+        /* Could not start a thread: do this slice on the caller's thread */
+        apThread[i] = 0;
+        walCkptCopyThread(&aWorker[i]);
+      }
+    }else{
+      /* The caller's thread handles the final slice itself */
+      walCkptCopyThread(&aWorker[i]);
+    }
+  }
+  for(i=0; i<nWorker-1; i++){
+    if( apThread[i] ){
+      void *pRet = 0;
+      int rc2 = sqlite3ThreadJoin(apThread[i], &pRet);
+      if( rc==SQLITE_OK ) rc = rc2;
+    }
+  }
+  for(i=0; i<nWorker; i++){
+    if( rc==SQLITE_OK ) rc = aWorker[i].rc;
+  }
+  sqlite3_free(aPair);
+  *pRc = rc;
+  return 1;
+}
+#endif /* SQLITE_MAX_WORKER_THREADS>0 */
+
 static int walCheckpoint(
   Wal *pWal,                      /* Wal connection */
   sqlite3 *db,                    /* Check for interrupts on this handle */
@@ -2093,6 +2409,14 @@ static int walCheckpoint(
       }
 
       /* Iterate through the contents of the WAL, copying data to the db file */
+#if SQLITE_MAX_WORKER_THREADS>0
+      if( rc==SQLITE_OK && xCb==0 && db->nCkptWorker>1
+       && walCheckpointParallel(pWal, db, &pIter, nBackfill, mxSafeFrame,
+                                mxPage, szPage, &rc)
+      ){
+        /* Backfill was performed by worker threads */
+      }else
+#endif
       while( rc==SQLITE_OK && 0==walIteratorRevNext(&pIter, &iDbpage, &iFrame) ){
         i64 iOffset;
         assert( walFramePgno(pWal, iFrame)==iDbpage );
@@ -2104,10 +2428,11 @@ static int walCheckpoint(
         if( iFrame<=nBackfill || iFrame>mxSafeFrame || iDbpage>mxPage ){
           continue;
         }
-        iOffset = walFrameOffset(iFrame, szPage) + WAL_FRAME_HDRSIZE;
         /* testcase( IS_BIG_INT(iOffset) ); // requires a 4GiB WAL file */
-        rc = sqlite3OsRead(pWal->pWalFd, zBuf, szPage, iOffset);
+        rc = walReadFrameContent(pWal, iFrame, szPage, zBuf, szPage, 0);
         if( rc!=SQLITE_OK ) break;
+        iOffset = 0;  /* Silence set-but-unused warnings */
+        (void)iOffset;
         iOffset = (iDbpage-1)*(i64)szPage;
         testcase( IS_BIG_INT(iOffset) );
         rc = sqlite3OsWrite(pWal->pDbFd, zBuf, szPage, iOffset);
@@ -2272,6 +2597,8 @@ static int sqlite3WalClose(
       }
     }
 
+    walGroupDetach(pWal);
+    sqlite3_free(pWal->aCmpBuf);
     walIndexClose(pWal, isDelete);
     sqlite3OsClose(pWal->pWalFd);
     if( isDelete ){
@@ -2451,7 +2778,35 @@ static int walIndexReadHdr(Wal *pWal, int *pChanged){
   ** sure the wal-index was not constructed with some future format that
   ** this version of SQLite cannot understand.
   */
-  if( badHdr==0 && pWal->hdr.iVersion!=WALINDEX_MAX_VERSION ){
+  if( badHdr==0 && pWal->hdr.iVersion==WALINDEX_CMP_VERSION ){
+#ifdef SQLITE_ENABLE_WAL_COMPRESSION
+    /* The wal-index is a rebuildable cache; the WAL file header is
+    ** authoritative about the frame format.  Accept the compressed
+    ** format only if the file agrees - an index claiming compression
+    ** over an ordinary WAL (a corrupt or hand-edited header) must fail
+    ** like any other unknown version rather than misparse frames.  An
+    ** index with no frames (e.g. just after a TRUNCATE checkpoint, when
+    ** the file may be empty) has nothing to misparse and is accepted;
+    ** the next writer rewrites the header for its own format anyway. */
+    if( pWal->bCompress==0 && pWal->hdr.mxFrame>0 ){
+      u8 aMagic[4];
+      rc = sqlite3OsRead(pWal->pWalFd, aMagic, 4, 0);
+      if( rc==SQLITE_OK ){
+        if( (sqlite3Get4byte(aMagic)&0xFFFFFFFE)==(WAL_CMAGIC&0xFFFFFFFE) ){
+          pWal->bCompress = 1;
+        }else{
+          rc = SQLITE_CANTOPEN_BKPT;
+        }
+      }else if( rc==SQLITE_IOERR_SHORT_READ ){
+        rc = SQLITE_CANTOPEN_BKPT;
+      }
+    }
+#else
+    rc = SQLITE_CANTOPEN_BKPT;
+#endif
+  }else if( badHdr==0 && pWal->hdr.iVersion==WALINDEX_MAX_VERSION ){
+    pWal->bCompress = 0;
+  }else if( badHdr==0 ){
     rc = SQLITE_CANTOPEN_BKPT;
   }
   if( pWal->bShmUnreliable ){
@@ -2592,7 +2947,7 @@ static int walBeginShmUnreliable(Wal *pWal, int *pChanged){
   /* Allocate a buffer to read frames into */
   assert( (pWal->szPage & (pWal->szPage-1))==0 );
   assert( pWal->szPage>=512 && pWal->szPage<=65536 );
-  szFrame = pWal->szPage + WAL_FRAME_HDRSIZE;
+  szFrame = walFrameSz(pWal, pWal->szPage);
   aFrame = (u8 *)sqlite3_malloc64(szFrame);
   if( aFrame==0 ){
     rc = SQLITE_NOMEM_BKPT;
@@ -2606,7 +2961,7 @@ static int walBeginShmUnreliable(Wal *pWal, int *pChanged){
   ** the caller.  */
   aSaveCksum[0] = pWal->hdr.aFrameCksum[0];
   aSaveCksum[1] = pWal->hdr.aFrameCksum[1];
-  for(iOffset=walFrameOffset(pWal->hdr.mxFrame+1, pWal->szPage);
+  for(iOffset=walFrameOffsetW(pWal, pWal->hdr.mxFrame+1, pWal->szPage);
       iOffset+szFrame<=szWal;
       iOffset+=szFrame
   ){
@@ -2935,8 +3290,8 @@ static int walSnapshotRecover(
       iDbOff = (i64)(pgno-1) * szPage;
 
       if( iDbOff+szPage<=szDb ){
-        iWalOff = walFrameOffset(i, szPage) + WAL_FRAME_HDRSIZE;
-        rc = sqlite3OsRead(pWal->pWalFd, pBuf1, szPage, iWalOff);
+        iWalOff = 0; (void)iWalOff;
+        rc = walReadFrameContent(pWal, i, szPage, pBuf1, szPage, 0);
 
         if( rc==SQLITE_OK ){
           rc = sqlite3OsRead(pWal->pDbFd, pBuf2, szPage, iDbOff);
@@ -3263,16 +3618,62 @@ static int walFindFrame(
 ** The difference between this function and walFindFrame() is that this
 ** function wraps walFindFrame() in an SEH_TRY{...} block.
 */
+/*
+** If pWal is the built-in WAL implementation, write the mxFrame of the
+** snapshot that the current read transaction sees into *pnFrame and
+** return SQLITE_OK.  Return SQLITE_MISUSE for other WAL
+** implementations (the caller falls back to reporting "unsupported").
+** Used by libsql_wal_frame()/libsql_wal_wait_frame() in main.c.
+*/
+int sqlite3WalFindFrame(Wal*, Pgno, u32*);
+int libsql_wal_frame_count(libsql_wal *pMethods, unsigned int *pnFrame){
+  if( pMethods==0
+   || pMethods->methods.xFindFrame
+        != (int(*)(wal_impl*,unsigned int,unsigned int*))sqlite3WalFindFrame
+  ){
+    return SQLITE_MISUSE;
+  }
+  *pnFrame = ((Wal*)pMethods->pData)->hdr.mxFrame;
+  return SQLITE_OK;
+}
+
 int sqlite3WalFindFrame(
   Wal *pWal,                      /* WAL handle */
   Pgno pgno,                      /* Database page number to read data for */
   u32 *piRead                     /* OUT: Frame number (or zero) */
 ){
   int rc;
+  int iSlot = pgno & (ArraySize(pWal->aFindPgno)-1);
+
+  /* Serve repeat lookups from the direct-mapped cache.  The cache is
+  ** valid only while the visible frame range is unchanged; both hits
+  ** and misses (aFindFrame[]==0) are worth remembering, since a miss
+  ** otherwise probes the hash table of every WAL segment. */
+  if( pWal->iFindCacheMx==pWal->hdr.mxFrame
+   && pWal->iFindCacheMin==pWal->minFrame
+   && pWal->aFindCacheSalt[0]==pWal->hdr.aSalt[0]
+   && pWal->aFindCacheSalt[1]==pWal->hdr.aSalt[1]
+  ){
+    if( pWal->aFindPgno[iSlot]==pgno ){
+      *piRead = pWal->aFindFrame[iSlot];
+      return SQLITE_OK;
+    }
+  }else{
+    memset(pWal->aFindPgno, 0, sizeof(pWal->aFindPgno));
+    pWal->iFindCacheMx = pWal->hdr.mxFrame;
+    pWal->iFindCacheMin = pWal->minFrame;
+    pWal->aFindCacheSalt[0] = pWal->hdr.aSalt[0];
+    pWal->aFindCacheSalt[1] = pWal->hdr.aSalt[1];
+  }
+
   SEH_TRY {
     rc = walFindFrame(pWal, pgno, pWal->hdr.mxFrame, piRead);
   }
   SEH_EXCEPT( rc = SQLITE_IOERR_IN_PAGE; )
+  if( rc==SQLITE_OK ){
+    pWal->aFindPgno[iSlot] = pgno;
+    pWal->aFindFrame[iSlot] = *piRead;
+  }
   return rc;
 }
 
@@ -3288,14 +3689,12 @@ static int sqlite3WalReadFrame(
   u8 *pOut                        /* Buffer to write page data to */
 ){
   int sz;
-  i64 iOffset;
   sz = pWal->hdr.szPage;
   sz = (sz&0xfe00) + ((sz&0x0001)<<16);
   testcase( sz<=32768 );
   testcase( sz>=65536 );
-  iOffset = walFrameOffset(iRead, sz) + WAL_FRAME_HDRSIZE;
   /* testcase( IS_BIG_INT(iOffset) ); // requires a 4GiB WAL */
-  return sqlite3OsRead(pWal->pWalFd, pOut, (nOut>sz ? sz : nOut), iOffset);
+  return walReadFrameContent(pWal, iRead, sz, pOut, nOut, 0);
 }
 
 /*
@@ -3399,6 +3798,22 @@ static int sqlite3WalEndWriteTransaction(Wal *pWal){
 */
 static int sqlite3WalUndo(Wal *pWal, int (*xUndo)(void *, Pgno), void *pUndoCtx){
   int rc = SQLITE_OK;
+  if( pWal->writeLock==0 ){
+    /* Arriving here without the WRITER lock is legitimate in two cases:
+    **
+    **   - PRAGMA concurrent_writes defers the lock until commit, so a
+    **     rollback of a transaction that never spilled (or that lost
+    **     the commit race with SQLITE_BUSY_SNAPSHOT) has no lock and
+    **     wrote no frames - there is nothing to undo.
+    **
+    **   - A group-commit fsync failed after the commit had already
+    **     been published and the lock dropped (see walFrames()).  The
+    **     transaction is committed and visible to other connections,
+    **     so nothing can be undone; the SQLITE_IOERR returned by
+    **     walFrames() reports the durability failure to the caller.
+    */
+    return SQLITE_OK;
+  }
   if( ALWAYS(pWal->writeLock) ){
     Pgno iMax = pWal->hdr.mxFrame;
     Pgno iFrame;
@@ -3593,16 +4008,33 @@ static int walWriteOneFrame(
 ){
   int rc;                         /* Result code from subfunctions */
   void *pData;                    /* Data actually written */
+  const u8 *aContent;             /* On-disk content image */
+  int nContent;                   /* Size of aContent in bytes */
   u8 aFrame[WAL_FRAME_HDRSIZE];   /* Buffer to assemble frame-header in */
   pData = pPage->pData;
   rc = libsql_pager_codec(pPage, &pData);
   if( rc ) return rc;
 
-  walEncodeFrame(p->pWal, pPage->pgno, nTruncate, pData, aFrame);
+  rc = walFrameContent(p->pWal, (const u8*)pData, &aContent, &nContent);
+  if( rc ) return rc;
+  walEncodeFrame(p->pWal, pPage->pgno, nTruncate, aContent, nContent, aFrame);
   rc = walWriteToLog(p, aFrame, sizeof(aFrame), iOffset);
   if( rc ) return rc;
-  /* Write the page data */
-  rc = walWriteToLog(p, pData, p->szPage, iOffset+sizeof(aFrame));
+  /* Write the content image */
+  rc = walWriteToLog(p, (void*)aContent, nContent, iOffset+sizeof(aFrame));
+  if( rc ) return rc;
+  if( p->pWal->bCompress
+   && nTruncate>0
+   && nContent<walFrameContentSz(p->pWal, p->szPage)
+  ){
+    /* Commit frame of a compressed WAL: extend the file to the end of
+    ** the frame slot so that recovery's fixed-size frame reads (and the
+    ** iLastFrame estimate derived from the file size) cover this frame.
+    ** The bytes in the gap are never looked at. */
+    static const u8 aZero[8] = {0,0,0,0,0,0,0,0};
+    rc = walWriteToLog(p, (void*)aZero, 8,
+        iOffset + sizeof(aFrame) + walFrameContentSz(p->pWal, p->szPage) - 8);
+  }
   return rc;
 }
 
@@ -3622,7 +4054,7 @@ static int walRewriteChecksums(Wal *pWal, u32 iLast){
   u32 iRead;                      /* Next frame to read from wal file */
   i64 iCksumOff;
 
-  aBuf = sqlite3_malloc(szPage + WAL_FRAME_HDRSIZE);
+  aBuf = sqlite3_malloc(walFrameSz(pWal, szPage));
   if( aBuf==0 ) return SQLITE_NOMEM_BKPT;
 
   /* Find the checksum values to use as input for the recalculating the
@@ -3634,7 +4066,7 @@ static int walRewriteChecksums(Wal *pWal, u32 iLast){
   if( pWal->iReCksum==1 ){
     iCksumOff = 24;
   }else{
-    iCksumOff = walFrameOffset(pWal->iReCksum-1, szPage) + 16;
+    iCksumOff = walFrameOffsetW(pWal, pWal->iReCksum-1, szPage) + 16;
   }
   rc = sqlite3OsRead(pWal->pWalFd, aBuf, sizeof(u32)*2, iCksumOff);
   pWal->hdr.aFrameCksum[0] = sqlite3Get4byte(aBuf);
@@ -3643,14 +4075,19 @@ static int walRewriteChecksums(Wal *pWal, u32 iLast){
   iRead = pWal->iReCksum;
   pWal->iReCksum = 0;
   for(; rc==SQLITE_OK && iRead<=iLast; iRead++){
-    i64 iOff = walFrameOffset(iRead, szPage);
-    rc = sqlite3OsRead(pWal->pWalFd, aBuf, szPage+WAL_FRAME_HDRSIZE, iOff);
+    i64 iOff = walFrameOffsetW(pWal, iRead, szPage);
+    rc = sqlite3OsRead(pWal->pWalFd, aBuf, walFrameSz(pWal,szPage), iOff);
     if( rc==SQLITE_OK ){
       u32 iPgno, nDbSize;
+      int nContent;
       iPgno = sqlite3Get4byte(aBuf);
       nDbSize = sqlite3Get4byte(&aBuf[4]);
-
-      walEncodeFrame(pWal, iPgno, nDbSize, &aBuf[WAL_FRAME_HDRSIZE], aFrame);
+      if( walFrameContentLen(pWal, &aBuf[WAL_FRAME_HDRSIZE], &nContent) ){
+        rc = SQLITE_CORRUPT_BKPT;
+        break;
+      }
+      walEncodeFrame(pWal, iPgno, nDbSize, &aBuf[WAL_FRAME_HDRSIZE],
+                     nContent, aFrame);
       rc = sqlite3OsWrite(pWal->pWalFd, aFrame, sizeof(aFrame), iOff);
     }
   }
@@ -3659,6 +4096,143 @@ static int walRewriteChecksums(Wal *pWal, u32 iLast){
   return rc;
 }
 
+/*
+** Group commit support (PRAGMA wal_group_commit).
+**
+** When a committer passes WAL_SYNC_GROUPCOMMIT in its sync-flags, the
+** commit fsync is not issued inside walFrames() while the WRITER lock is
+** held.  Instead the writer publishes its commit, drops the WRITER lock,
+** and then waits on the WalGroupCommit object shared by all connections
+** in this process that have the same wal-index mapped.  The first waiter
+** becomes the leader and issues one fsync covering every frame appended
+** so far - including frames committed by writers that arrived while the
+** previous fsync was in progress.  Each committer returns as soon as a
+** completed fsync covers its own commit frame, so N small transactions
+** cost one fsync each in the worst case and 1/N fsyncs each at peak.
+**
+** Because the fsync happens after the WRITER lock is dropped, another
+** process (or a connection not using group commit) may append frames to
+** a not-yet-durable WAL tail; this is the same exposure as
+** PRAGMA synchronous=NORMAL and, like that mode, group commit relies on
+** the powersafe-overwrite property for torn-sector safety.
+**
+** Error handling: if the deferred fsync fails, the transaction has
+** already been published and cannot be rolled back.  walFrames()
+** returns the I/O error so the application learns that durability was
+** not achieved, and sqlite3WalUndo() treats the subsequent rollback
+** attempt as a no-op (the commit stands; only its durability is in
+** doubt, exactly as for a synchronous=NORMAL commit before the next
+** checkpoint).
+*/
+typedef struct WalGroupCommit WalGroupCommit;
+struct WalGroupCommit {
+  sqlite3_mutex *pMutex;          /* Protects all fields below */
+  volatile void *pShmId;          /* apWiData[0]: identifies the wal-index */
+  u32 iSyncedFrame;               /* All frames <= this are known durable */
+  u32 mxSyncReq;                  /* Highest frame any waiter wants durable */
+  u32 iSalt;                      /* hdr.aSalt[0] the counters are valid for */
+  u8 syncInProgress;              /* True while the leader is in OsSync() */
+  int nRef;                       /* Number of Wal objects attached */
+  WalGroupCommit *pNext;          /* Next entry in walGroupList */
+};
+static WalGroupCommit *walGroupList = 0;
+
+/*
+** Attach pWal to the group-commit object for its wal-index, creating it
+** if this is the first connection in the process to ask for one.  On OOM
+** pWal->pGroup is left NULL and the caller falls back to a private fsync.
+*/
+static void walGroupAttach(Wal *pWal){
+  WalGroupCommit *p;
+  sqlite3_mutex *pMainMtx = sqlite3MutexAlloc(SQLITE_MUTEX_STATIC_MAIN);
+  volatile void *pShmId;
+  if( pWal->pGroup ) return;
+  assert( pWal->nWiData>0 && pWal->apWiData[0] );
+  pShmId = (volatile void*)pWal->apWiData[0];
+  sqlite3_mutex_enter(pMainMtx);
+  for(p=walGroupList; p && p->pShmId!=pShmId; p=p->pNext){}
+  if( p==0 ){
+    p = (WalGroupCommit*)sqlite3MallocZero(sizeof(WalGroupCommit));
+    if( p ){
+      p->pMutex = sqlite3_mutex_alloc(SQLITE_MUTEX_FAST);
+      p->pShmId = pShmId;
+      p->pNext = walGroupList;
+      walGroupList = p;
+    }
+  }
+  if( p ) p->nRef++;
+  sqlite3_mutex_leave(pMainMtx);
+  pWal->pGroup = p;
+}
+
+/*
+** Detach pWal from its group-commit object, freeing the object when the
+** last reference in the process is dropped.
+*/
+static void walGroupDetach(Wal *pWal){
+  WalGroupCommit *p = pWal->pGroup;
+  if( p ){
+    sqlite3_mutex *pMainMtx = sqlite3MutexAlloc(SQLITE_MUTEX_STATIC_MAIN);
+    sqlite3_mutex_enter(pMainMtx);
+    if( (--p->nRef)==0 ){
+      WalGroupCommit **pp;
+      for(pp=&walGroupList; *pp!=p; pp=&(*pp)->pNext){ assert( *pp ); }
+      *pp = p->pNext;
+      sqlite3_mutex_free(p->pMutex);
+      sqlite3_free(p);
+    }
+    sqlite3_mutex_leave(pMainMtx);
+    pWal->pGroup = 0;
+  }
+}
+
+/*
+** Block until every frame up to and including iTarget is durable in the
+** WAL file, issuing at most one fsync of our own.  Called without any
+** WAL locks held.
+*/
+static int walGroupSync(Wal *pWal, u32 iTarget, int syncFlags){
+  WalGroupCommit *p = pWal->pGroup;
+  int rc = SQLITE_OK;
+  assert( p );
+  sqlite3_mutex_enter(p->pMutex);
+  if( p->iSalt!=pWal->hdr.aSalt[0] ){
+    /* The WAL has been restarted since the counters were last valid.
+    ** Frame numbers from before the restart mean nothing now. */
+    p->iSalt = pWal->hdr.aSalt[0];
+    p->iSyncedFrame = 0;
+    p->mxSyncReq = 0;
+  }
+  if( p->mxSyncReq<iTarget ) p->mxSyncReq = iTarget;
+  while( p->iSyncedFrame<iTarget && rc==SQLITE_OK ){
+    if( p->syncInProgress ){
+      /* Another connection's fsync is in flight.  It may not cover our
+      ** commit frame, so re-check when it completes. */
+      sqlite3_mutex_leave(p->pMutex);
+      sqlite3OsSleep(pWal->pVfs, 50);
+      sqlite3_mutex_enter(p->pMutex);
+    }else{
+      u32 iSyncing = p->mxSyncReq;   /* >= iTarget */
+      p->syncInProgress = 1;
+      sqlite3_mutex_leave(p->pMutex);
+      rc = sqlite3OsSync(pWal->pWalFd, syncFlags);
+      sqlite3_mutex_enter(p->pMutex);
+      p->syncInProgress = 0;
+      if( rc==SQLITE_OK ){
+        /* Our own frames are durable now regardless of whether the
+        ** shared counters are still talking about the same WAL
+        ** generation, so only the bookkeeping is conditional. */
+        if( p->iSyncedFrame<iSyncing && p->iSalt==pWal->hdr.aSalt[0] ){
+          p->iSyncedFrame = iSyncing;
+        }
+        break;
+      }
+    }
+  }
+  sqlite3_mutex_leave(p->pMutex);
+  return rc;
+}
+
 /*
 ** Write a set of frames to the log. The caller must hold the write-lock
 ** on the log file (obtained using sqlite3WalBeginWriteTransaction()).
@@ -3683,10 +4257,28 @@ static int walFrames(
   u32 iFirst = 0;                 /* First frame that may be overwritten */
   WalIndexHdr *pLive;             /* Pointer to shared header */
   int walRestarted;               /* Whether the wal was restarted */
+  int useGroup = 0;               /* True to defer the commit fsync */
 
   assert( pList );
+  if( !pWal->writeLock && (sync_flags & WAL_SYNC_OPTIMISTIC)!=0 ){
+    /* Deferred WRITER lock (PRAGMA concurrent_writes).  This also
+    ** validates that no other transaction has committed since this
+    ** transaction's snapshot was taken, returning SQLITE_BUSY_SNAPSHOT
+    ** if one has. */
+    int rc2 = sqlite3WalBeginWriteTransaction(pWal);
+    if( rc2!=SQLITE_OK ) return rc2;
+  }
   assert( pWal->writeLock );
 
+  /* Decide up front whether this commit takes part in group commit.  If
+  ** the attach fails (OOM) the commit falls back to a private fsync. */
+  if( isCommit && (sync_flags & WAL_SYNC_GROUPCOMMIT)!=0
+   && WAL_SYNC_FLAGS(sync_flags)!=0
+  ){
+    walGroupAttach(pWal);
+    useGroup = (pWal->pGroup!=0);
+  }
+
   /* If this frame set completes a transaction, then nTruncate>0.  If
   ** nTruncate==0 then this frame set does not complete the transaction. */
   assert( (isCommit!=0)==(nTruncate!=0) );
@@ -3719,7 +4311,17 @@ static int walFrames(
     u8 aWalHdr[WAL_HDRSIZE];      /* Buffer to assemble wal-header in */
     u32 aCksum[2];                /* Checksum for wal-header */
 
-    sqlite3Put4byte(&aWalHdr[0], (WAL_MAGIC | SQLITE_BIGENDIAN));
+#ifdef SQLITE_ENABLE_WAL_COMPRESSION
+    /* A new WAL file is starting: the frame format may be switched to
+    ** or from the compressed variant according to the current setting
+    ** of PRAGMA wal_compression.  Existing WAL files keep the format
+    ** they were created with. */
+    pWal->bCompress = (sync_flags & WAL_SYNC_COMPRESS)!=0;
+    pWal->hdr.iVersion = pWal->bCompress ? WALINDEX_CMP_VERSION
+                                         : WALINDEX_MAX_VERSION;
+#endif
+    sqlite3Put4byte(&aWalHdr[0],
+        (pWal->bCompress ? WAL_CMAGIC : WAL_MAGIC) | SQLITE_BIGENDIAN);
     sqlite3Put4byte(&aWalHdr[4], WAL_MAX_VERSION);
     sqlite3Put4byte(&aWalHdr[8], szPage);
     sqlite3Put4byte(&aWalHdr[12], pWal->nCkpt);
@@ -3763,8 +4365,8 @@ static int walFrames(
   w.iSyncPoint = 0;
   w.syncFlags = sync_flags;
   w.szPage = szPage;
-  iOffset = walFrameOffset(iFrame+1, szPage);
-  szFrame = szPage + WAL_FRAME_HDRSIZE;
+  iOffset = walFrameOffsetW(pWal, iFrame+1, szPage);
+  szFrame = walFrameSz(pWal, szPage);
 
   /* Write all frames into the log file exactly once */
   for(p=pList; p; p=p->pDirty){
@@ -3779,7 +4381,7 @@ static int walFrames(
       VVA_ONLY(rc =) sqlite3WalFindFrame(pWal, p->pgno, &iWrite);
       assert( rc==SQLITE_OK || iWrite==0 );
       if( iWrite>=iFirst ){
-        i64 iOff = walFrameOffset(iWrite, szPage) + WAL_FRAME_HDRSIZE;
+        i64 iOff = walFrameOffsetW(pWal, iWrite, szPage) + WAL_FRAME_HDRSIZE;
         void *pData;
         if( pWal->iReCksum==0 || iWrite<pWal->iReCksum ){
           pWal->iReCksum = iWrite;
@@ -3787,7 +4389,13 @@ static int walFrames(
 
         rc = libsql_pager_codec(p, &pData);
         if( rc ) return rc;
-        rc = sqlite3OsWrite(pWal->pWalFd, pData, szPage, iOff);
+        {
+          const u8 *aContent;
+          int nContent;
+          rc = walFrameContent(pWal, (const u8*)pData, &aContent, &nContent);
+          if( rc ) return rc;
+          rc = sqlite3OsWrite(pWal->pWalFd, (void*)aContent, nContent, iOff);
+        }
         if( rc ) return rc;
         p->flags &= ~PGHDR_WAL_APPEND;
         continue;
@@ -3795,7 +4403,7 @@ static int walFrames(
     }
 
     iFrame++;
-    assert( iOffset==walFrameOffset(iFrame, szPage) );
+    assert( iOffset==walFrameOffsetW(pWal, iFrame, szPage) );
     nDbSize = (isCommit && p->pDirty==0) ? nTruncate : 0;
     rc = walWriteOneFrame(&w, p, nDbSize, iOffset);
     if( rc ) return rc;
@@ -3824,7 +4432,7 @@ static int walFrames(
   ** sector boundary is synced; the part of the last frame that extends
   ** past the sector boundary is written after the sync.
   */
-  if( isCommit && WAL_SYNC_FLAGS(sync_flags)!=0 ){
+  if( isCommit && WAL_SYNC_FLAGS(sync_flags)!=0 && !useGroup ){
     int bSync = 1;
     if( pWal->padToSectorBoundary ){
       int sectorSize = sqlite3SectorSize(pWal->pWalFd);
@@ -3851,8 +4459,8 @@ static int walFrames(
   */
   if( isCommit && pWal->truncateOnCommit && pWal->mxWalSize>=0 ){
     i64 sz = pWal->mxWalSize;
-    if( walFrameOffset(iFrame+nExtra+1, szPage)>pWal->mxWalSize ){
-      sz = walFrameOffset(iFrame+nExtra+1, szPage);
+    if( walFrameOffsetW(pWal, iFrame+nExtra+1, szPage)>pWal->mxWalSize ){
+      sz = walFrameOffsetW(pWal, iFrame+nExtra+1, szPage);
     }
     walLimitSize(pWal, sz);
     pWal->truncateOnCommit = 0;
@@ -3897,13 +4505,39 @@ static int walFrames(
       pWal->hdr.iChange++;
       pWal->hdr.nPage = nTruncate;
     }
-    /* If this is a commit, update the wal-index header too. */
+    /* If this is a commit, update the wal-index header too.  A VFS
+    ** that defers writes (unix-uring) must put every frame byte into
+    ** the file first: once the header is published, other connections
+    ** read the new frames through their own descriptors, which do not
+    ** see this connection's queued writes.  With synchronous=NORMAL no
+    ** commit-time xSync arrives to force that, so an explicit drain is
+    ** sent here; SQLITE_NOTFOUND means the VFS writes through.  A
+    ** drain failure fails the commit before it becomes visible. */
     if( isCommit ){
-      walIndexWriteHdr(pWal);
-      pWal->iCallback = iFrame;
+      rc = sqlite3OsFileControl(pWal->pWalFd, SQLITE_FCNTL_WRITE_DRAIN, 0);
+      if( rc==SQLITE_NOTFOUND ) rc = SQLITE_OK;
+      if( rc==SQLITE_OK ){
+        walIndexWriteHdr(pWal);
+        pWal->iCallback = iFrame;
+      }
     }
   }
 
+  if( useGroup && rc==SQLITE_OK ){
+    /* The commit is published.  Release the WRITER lock before syncing
+    ** so that other committers can append frames while the fsync is in
+    ** flight, then wait until a completed fsync covers our frames.
+    ** If the fsync fails the commit still stands - it is visible and
+    ** cannot be revoked - so the error below reports a durability
+    ** failure only; sqlite3WalUndo() knows not to undo in this state. */
+    u32 iTargetFrame = pWal->hdr.mxFrame;
+    walUnlockExclusive(pWal, WAL_WRITE_LOCK, 1);
+    pWal->writeLock = 0;
+    pWal->iReCksum = 0;
+    pWal->truncateOnCommit = 0;
+    rc = walGroupSync(pWal, iTargetFrame, WAL_SYNC_FLAGS(sync_flags));
+  }
+
   WALTRACE(("WAL%p: frame write %s\n", pWal, rc ? "failed" : "ok"));
   return rc;
 }
@@ -26,6 +26,24 @@
 #define WAL_SYNC_FLAGS(X)   ((X)&0x03)
 #define CKPT_SYNC_FLAGS(X)  (((X)>>2)&0x03)
 
+/* If this bit is set in the sync-flags passed to xFrames, the commit
+** fsync may be coalesced with the commit fsyncs of other connections to
+** the same WAL ("group commit" - see PRAGMA wal_group_commit).  The
+** committer still does not return until its own commit frame is durable. */
+#define WAL_SYNC_GROUPCOMMIT 0x10
+
+/* If this bit is set in the sync-flags passed to xFrames and the caller
+** does not yet hold the WRITER lock, the WAL implementation acquires it
+** and validates the caller's snapshot at that point ("optimistic" or
+** concurrent write transactions - see PRAGMA concurrent_writes).  An
+** intervening commit fails the transaction with SQLITE_BUSY_SNAPSHOT. */
+#define WAL_SYNC_OPTIMISTIC  0x20
+
+/* If this bit is set in the sync-flags passed to xFrames, new WAL files
+** are created in the compressed frame format (PRAGMA wal_compression;
+** only honored when built with SQLITE_ENABLE_WAL_COMPRESSION). */
+#define WAL_SYNC_COMPRESS    0x40
+
 #define WAL_SAVEPOINT_NDATA 4
 
 /* Connection to a write-ahead log (WAL) file. 
@@ -222,6 +240,22 @@ typedef struct sqlite3_wal {
   unsigned char lockError;            /* True if a locking error has occurred */
   WalIndexHdr *pSnapshot;             /* Start transaction here if not NULL */
   sqlite3 *db;
+  struct WalGroupCommit *pGroup;      /* Shared group-commit state, or NULL */
+  unsigned char bCompress;            /* True if frame content is compressed */
+  unsigned char *aCmpBuf;             /* Scratch for frame (de)compression */
+
+  /* Small direct-mapped cache of recent wal-index lookups.  With
+  ** multi-gigabyte WALs a lookup probes one hash table per 4096-frame
+  ** segment, so hot pages re-pay a long probe chain on every fetch.
+  ** Entries are valid only for the (salt, minFrame, mxFrame) snapshot
+  ** they were recorded under; the salts distinguish WAL generations,
+  ** since after a checkpoint-and-restart the same frame range can
+  ** reappear holding different pages. */
+  unsigned int iFindCacheMx;          /* hdr.mxFrame the cache is valid for */
+  unsigned int iFindCacheMin;         /* minFrame the cache is valid for */
+  unsigned int aFindCacheSalt[2];     /* hdr.aSalt[] the cache is valid for */
+  unsigned int aFindPgno[64];         /* Cached page numbers (0 = empty) */
+  unsigned int aFindFrame[64];        /* Cached lookup results */
 } sqlite3_wal;
 
 struct libsql_wal {
@@ -246,4 +280,6 @@ RefCountedWalManager *make_sqlite3_wal_manager_rc();
 
 extern const libsql_wal_manager sqlite3_wal_manager;
 
+int libsql_wal_frame_count(libsql_wal*, unsigned int*);
+
 #endif /* SQLITE_WAL_H */
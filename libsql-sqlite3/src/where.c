@@ -1048,9 +1048,21 @@ static SQLITE_NOINLINE void constructAutomaticIndex(
   sqlite3VdbeSetP4KeyInfo(pParse, pIdx);
   VdbeComment((v, "for %s", pTable->zName));
   if( OptimizationEnabled(pParse->db, SQLITE_BloomFilter) && useBloomFilter ){
+    u64 sz;
     sqlite3WhereExplainBloomFilter(pParse, pWC->pWInfo, pLevel);
     pLevel->regFilter = ++pParse->nMem;
-    sqlite3VdbeAddOp2(v, OP_Blob, 10000, pLevel->regFilter);
+    /* Size the Bloom filter from the build side's row estimate, the
+    ** same way sqlite3ConstructBloomFilter() does.  The old fixed 80K
+    ** bits saturated on large build sides, at which point every probe
+    ** fell through to the b-tree seek that the filter exists to
+    ** avoid. */
+    sz = sqlite3LogEstToInt(pSrc->pTab->nRowLogEst);
+    if( sz<10000 ){
+      sz = 10000;
+    }else if( sz>10000000 ){
+      sz = 10000000;
+    }
+    sqlite3VdbeAddOp2(v, OP_Blob, (int)sz, pLevel->regFilter);
   }
 
   /* Fill the automatic index with content */
@@ -5749,7 +5761,16 @@ static SQLITE_NOINLINE void whereCheckIfBloomFilterIsUseful(
     const unsigned int reqFlags = (WHERE_SELFCULL|WHERE_COLUMN_EQ);
     SrcItem *pItem = &pWInfo->pTabList->a[pLoop->iTab];
     Table *pTab = pItem->pTab;
-    if( (pTab->tabFlags & TF_HasStat1)==0 ) break;
+    if( (pTab->tabFlags & TF_HasStat1)==0 ){
+      /* No statistics for this table.  Its own search cannot be
+      ** filter-qualified, but its estimated output still feeds the
+      ** lookup count, so deeper levels that do have statistics can
+      ** still earn a filter.  Earlier this aborted the whole chain,
+      ** which silently disabled filters on every join level below the
+      ** first unanalyzed table. */
+      nSearch += pLoop->nOut;
+      continue;
+    }
     pTab->tabFlags |= TF_StatsUsed;
     if( i>=1
      && (pLoop->wsFlags & reqFlags)==reqFlags
@@ -805,7 +805,7 @@ static int selectWindowRewriteExprCb(Walker *pWalker, Expr *pExpr){
         p->pSub = sqlite3ExprListAppend(pParse, p->pSub, pDup);
       }
       if( p->pSub ){
-        int f = pExpr->flags & EP_Collate;
+        int f = pExpr->flags & (EP_Collate|EP_Arena);
         assert( ExprHasProperty(pExpr, EP_Static)==0 );
         ExprSetProperty(pExpr, EP_Static);
         sqlite3ExprDelete(pParse->db, pExpr);
@@ -1414,9 +1414,13 @@ void sqlite3WindowCodeInit(Parse *pParse, Select *pSelect){
   if( pMWin->eExclude ){
     pMWin->regStartRowid = ++pParse->nMem;
     pMWin->regEndRowid = ++pParse->nMem;
+    pMWin->regMemoStart = ++pParse->nMem;
+    pMWin->regMemoEnd = ++pParse->nMem;
     pMWin->csrApp = pParse->nTab++;
     sqlite3VdbeAddOp2(v, OP_Integer, 1, pMWin->regStartRowid);
     sqlite3VdbeAddOp2(v, OP_Integer, 0, pMWin->regEndRowid);
+    sqlite3VdbeAddOp2(v, OP_Null, 0, pMWin->regMemoStart);
+    sqlite3VdbeAddOp2(v, OP_Null, 0, pMWin->regMemoEnd);
     sqlite3VdbeAddOp2(v, OP_OpenDup, pMWin->csrApp, pMWin->iEphCsr);
     return;
   }
@@ -1821,6 +1825,7 @@ static void windowFullScan(WindowCodeArg *p){
   int nPeer;
   int lblNext;
   int lblBrk;
+  int lblSkip = 0;
   int addrNext;
   int csr;
 
@@ -1833,6 +1838,26 @@ static void windowFullScan(WindowCodeArg *p){
   lblNext = sqlite3VdbeMakeLabel(pParse);
   lblBrk = sqlite3VdbeMakeLabel(pParse);
 
+  if( pMWin->eExclude==TK_NO ){
+    /* Rows that are peers share identical frame boundaries, and without
+    ** an EXCLUDE clause identical boundaries mean an identical frame.
+    ** Remember the boundaries of the frame scanned last time and skip
+    ** the rescan - and the finalizers - when they have not moved.  This
+    ** turns the O(frame) cost per output row into O(frame) per distinct
+    ** frame, which for RANGE frames over low-cardinality orderings is
+    ** the difference described as "incremental frame evaluation". */
+    assert( pMWin->regMemoStart>0 );
+    lblSkip = sqlite3VdbeMakeLabel(pParse);
+    sqlite3VdbeAddOp3(v, OP_Ne, pMWin->regStartRowid,
+                      sqlite3VdbeCurrentAddr(v)+2, pMWin->regMemoStart);
+    VdbeCoverage(v);
+    sqlite3VdbeAddOp3(v, OP_Eq, pMWin->regEndRowid, lblSkip,
+                      pMWin->regMemoEnd);
+    VdbeCoverage(v);
+    sqlite3VdbeAddOp2(v, OP_Copy, pMWin->regStartRowid, pMWin->regMemoStart);
+    sqlite3VdbeAddOp2(v, OP_Copy, pMWin->regEndRowid, pMWin->regMemoEnd);
+  }
+
   regCRowid = sqlite3GetTempReg(pParse);
   regRowid = sqlite3GetTempReg(pParse);
   if( nPeer ){
@@ -1897,6 +1922,7 @@ static void windowFullScan(WindowCodeArg *p){
   }
 
   windowAggFinal(p, 1);
+  if( lblSkip ) sqlite3VdbeResolveLabel(v, lblSkip);
   VdbeModuleComment((v, "windowFullScan end"));
 }
 
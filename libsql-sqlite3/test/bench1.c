@@ -0,0 +1,314 @@
+/*
+** 2026-09-01
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+**
+** A micro-benchmark harness for the hot paths of the library.  Build
+** and run with "make bench".  Each benchmark uses a fixed seed and a
+** fixed workload so that two runs of the same binary - or of binaries
+** built from two different checkouts - are directly comparable:
+**
+**     ./bench1                 run everything, print a table
+**     ./bench1 prefix          run only benchmarks whose name matches
+**     ./bench1 -scale N        multiply workload sizes by N
+**
+** Timings are wall-clock microseconds per operation over the whole
+** workload, which is stable enough at the default sizes to show
+** regressions of a few percent.  The database lives in memory (or in
+** /tmp for the WAL commit benchmark, which needs a real file to sync).
+*/
+#include "sqlite3.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+static int giScale = 1;
+
+static sqlite3_int64 benchNow(void){
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return (sqlite3_int64)tv.tv_sec*1000000 + tv.tv_usec;
+}
+
+/* Deterministic PRNG so workloads do not depend on sqlite3_randomness */
+static unsigned int gSeed = 0x2fab1e;
+static unsigned int benchRand(void){
+  gSeed = gSeed*1103515245 + 12345;
+  return (gSeed>>8) & 0x7fffffff;
+}
+
+static void benchExec(sqlite3 *db, const char *zSql){
+  char *zErr = 0;
+  if( sqlite3_exec(db, zSql, 0, 0, &zErr)!=SQLITE_OK ){
+    fprintf(stderr, "SQL error: %s\n  in: %s\n", zErr, zSql);
+    exit(1);
+  }
+}
+
+static void benchReport(const char *zName, sqlite3_int64 nUsec, sqlite3_int64 nOp){
+  printf("%-28s %12lld ops %12.3f usec/op %10.1f Kops/s\n",
+         zName, (long long)nOp, (double)nUsec/(double)nOp,
+         nOp*1000.0/(nUsec ? nUsec : 1));
+  fflush(stdout);
+}
+
+/* Point lookups through the b-tree on a rowid table */
+static void benchPointLookup(void){
+  sqlite3 *db;
+  sqlite3_stmt *pStmt;
+  int nRow = 100000*giScale;
+  sqlite3_int64 nOp = 500000*(sqlite3_int64)giScale;
+  sqlite3_int64 t, i, ck = 0;
+
+  sqlite3_open(":memory:", &db);
+  benchExec(db, "CREATE TABLE t(a INTEGER PRIMARY KEY, b)");
+  benchExec(db, "BEGIN");
+  sqlite3_prepare_v2(db, "INSERT INTO t VALUES(?1,?1+1)", -1, &pStmt, 0);
+  for(i=0; i<nRow; i++){
+    sqlite3_bind_int64(pStmt, 1, i);
+    sqlite3_step(pStmt);
+    sqlite3_reset(pStmt);
+  }
+  sqlite3_finalize(pStmt);
+  benchExec(db, "COMMIT");
+
+  sqlite3_prepare_v2(db, "SELECT b FROM t WHERE a=?1", -1, &pStmt, 0);
+  t = benchNow();
+  for(i=0; i<nOp; i++){
+    sqlite3_bind_int64(pStmt, 1, benchRand()%nRow);
+    if( sqlite3_step(pStmt)==SQLITE_ROW ) ck += sqlite3_column_int64(pStmt, 0);
+    sqlite3_reset(pStmt);
+  }
+  t = benchNow()-t;
+  sqlite3_finalize(pStmt);
+  sqlite3_close(db);
+  if( ck==42 ) printf("!");   /* Keep the loop live */
+  benchReport("btree-point-lookup", t, nOp);
+}
+
+/* VDBE dispatch: a tight aggregate scan */
+static void benchVdbeScan(void){
+  sqlite3 *db;
+  sqlite3_stmt *pStmt;
+  int nRow = 1000000*giScale;
+  sqlite3_int64 t;
+  int nRep = 5, i;
+
+  sqlite3_open(":memory:", &db);
+  benchExec(db, "CREATE TABLE t(a INTEGER PRIMARY KEY, b INT, c INT)");
+  {
+    char *z = sqlite3_mprintf(
+      "WITH RECURSIVE s(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM s WHERE x<%d)"
+      "INSERT INTO t SELECT x, x%%97, x%%31 FROM s", nRow);
+    benchExec(db, z);
+    sqlite3_free(z);
+  }
+  sqlite3_prepare_v2(db, "SELECT sum(b), count(*) FROM t WHERE c<>5", -1,
+                     &pStmt, 0);
+  t = benchNow();
+  for(i=0; i<nRep; i++){
+    while( sqlite3_step(pStmt)==SQLITE_ROW ){}
+    sqlite3_reset(pStmt);
+  }
+  t = benchNow()-t;
+  sqlite3_finalize(pStmt);
+  sqlite3_close(db);
+  benchReport("vdbe-aggregate-scan", t, (sqlite3_int64)nRow*nRep);
+}
+
+/* WAL transaction commit rate against a real file */
+static void benchWalCommit(void){
+  sqlite3 *db;
+  sqlite3_stmt *pStmt;
+  sqlite3_int64 nOp = 2000*(sqlite3_int64)giScale;
+  sqlite3_int64 t, i;
+
+  unlink("/tmp/bench1.db");
+  unlink("/tmp/bench1.db-wal");
+  unlink("/tmp/bench1.db-shm");
+  sqlite3_open("/tmp/bench1.db", &db);
+  benchExec(db, "PRAGMA journal_mode=WAL");
+  benchExec(db, "PRAGMA synchronous=NORMAL");
+  benchExec(db, "CREATE TABLE t(a INTEGER PRIMARY KEY, b)");
+  sqlite3_prepare_v2(db, "INSERT INTO t VALUES(?1,?1)", -1, &pStmt, 0);
+  t = benchNow();
+  for(i=0; i<nOp; i++){
+    sqlite3_bind_int64(pStmt, 1, i);
+    sqlite3_step(pStmt);
+    sqlite3_reset(pStmt);
+  }
+  t = benchNow()-t;
+  sqlite3_finalize(pStmt);
+  sqlite3_close(db);
+  unlink("/tmp/bench1.db");
+  benchReport("wal-autocommit-insert", t, nOp);
+}
+
+/* Sorter throughput: external-ish ORDER BY over random keys */
+static void benchSorter(void){
+  sqlite3 *db;
+  sqlite3_stmt *pStmt;
+  int nRow = 500000*giScale;
+  sqlite3_int64 t, ck = 0;
+  char *z;
+
+  sqlite3_open(":memory:", &db);
+  benchExec(db, "CREATE TABLE t(a INT, b TEXT)");
+  benchExec(db, "BEGIN");
+  sqlite3_prepare_v2(db, "INSERT INTO t VALUES(?1,?2)", -1, &pStmt, 0);
+  {
+    sqlite3_int64 i;
+    char zVal[32];
+    for(i=0; i<nRow; i++){
+      unsigned int r = benchRand();
+      sqlite3_bind_int(pStmt, 1, (int)r);
+      sqlite3_snprintf(sizeof(zVal), zVal, "k%010u", r);
+      sqlite3_bind_text(pStmt, 2, zVal, -1, SQLITE_TRANSIENT);
+      sqlite3_step(pStmt);
+      sqlite3_reset(pStmt);
+    }
+  }
+  sqlite3_finalize(pStmt);
+  benchExec(db, "COMMIT");
+
+  z = "SELECT count(*) FROM (SELECT a FROM t ORDER BY a)";
+  sqlite3_prepare_v2(db, z, -1, &pStmt, 0);
+  t = benchNow();
+  while( sqlite3_step(pStmt)==SQLITE_ROW ){ ck += sqlite3_column_int64(pStmt,0); }
+  t = benchNow()-t;
+  sqlite3_finalize(pStmt);
+  sqlite3_close(db);
+  if( ck==42 ) printf("!");
+  benchReport("sorter-order-by", t, nRow);
+}
+
+/* JSON parse and extract */
+static void benchJson(void){
+  sqlite3 *db;
+  sqlite3_stmt *pStmt;
+  sqlite3_int64 nOp = 200000*(sqlite3_int64)giScale;
+  sqlite3_int64 t, i, ck = 0;
+
+  sqlite3_open(":memory:", &db);
+  sqlite3_prepare_v2(db,
+    "SELECT json_extract(?1, '$.payload.items[3]'), json_extract(?1, '$.id')",
+    -1, &pStmt, 0);
+  {
+    static const char *zDoc =
+      "{\"id\":12345,\"name\":\"a moderately long name string here\","
+      "\"payload\":{\"items\":[1,2,3,4,5,6,7,8],\"note\":"
+      "\"the quick brown fox jumps over the lazy dog repeatedly\"},"
+      "\"flags\":[true,false,null,1.5,\"x\"]}";
+    t = benchNow();
+    for(i=0; i<nOp; i++){
+      sqlite3_bind_text(pStmt, 1, zDoc, -1, SQLITE_STATIC);
+      if( sqlite3_step(pStmt)==SQLITE_ROW ) ck += sqlite3_column_int(pStmt, 1);
+      sqlite3_reset(pStmt);
+    }
+    t = benchNow()-t;
+  }
+  sqlite3_finalize(pStmt);
+  sqlite3_close(db);
+  if( ck==42 ) printf("!");
+  benchReport("json-extract", t, nOp);
+}
+
+/* Multi-process WAL write contention, in the spirit of the mptest
+** scenarios but reporting throughput: four forked writers autocommit
+** inserts into one WAL database with a busy timeout, and the figure
+** reported is aggregate committed inserts per second. */
+#include <sys/wait.h>
+static void benchWalContention(void){
+  static const int nProc = 4;
+  sqlite3_int64 nOp = 1000*(sqlite3_int64)giScale;
+  sqlite3_int64 t;
+  int iProc, st;
+
+  unlink("/tmp/bench1c.db");
+  unlink("/tmp/bench1c.db-wal");
+  unlink("/tmp/bench1c.db-shm");
+  {
+    sqlite3 *db;
+    sqlite3_open("/tmp/bench1c.db", &db);
+    benchExec(db, "PRAGMA journal_mode=WAL");
+    benchExec(db, "CREATE TABLE t(a INTEGER PRIMARY KEY, b)");
+    sqlite3_close(db);
+  }
+  t = benchNow();
+  for(iProc=0; iProc<nProc; iProc++){
+    if( fork()==0 ){
+      sqlite3 *db;
+      sqlite3_stmt *pStmt;
+      sqlite3_int64 i;
+      sqlite3_open("/tmp/bench1c.db", &db);
+      benchExec(db, "PRAGMA busy_timeout=10000");
+      benchExec(db, "PRAGMA synchronous=NORMAL");
+      sqlite3_prepare_v2(db, "INSERT INTO t(b) VALUES(?1)", -1, &pStmt, 0);
+      for(i=0; i<nOp; i++){
+        sqlite3_bind_int64(pStmt, 1, i);
+        while( sqlite3_step(pStmt)==SQLITE_BUSY ){}
+        sqlite3_reset(pStmt);
+      }
+      sqlite3_finalize(pStmt);
+      sqlite3_close(db);
+      _exit(0);
+    }
+  }
+  for(iProc=0; iProc<nProc; iProc++) wait(&st);
+  t = benchNow()-t;
+  {
+    sqlite3 *db;
+    sqlite3_stmt *pStmt;
+    sqlite3_open("/tmp/bench1c.db", &db);
+    sqlite3_prepare_v2(db, "SELECT count(*) FROM t", -1, &pStmt, 0);
+    if( sqlite3_step(pStmt)==SQLITE_ROW
+     && sqlite3_column_int64(pStmt,0)!=nOp*nProc ){
+      fprintf(stderr, "wal-contention: row count mismatch\n");
+    }
+    sqlite3_finalize(pStmt);
+    sqlite3_close(db);
+  }
+  unlink("/tmp/bench1c.db");
+  benchReport("wal-contention-4proc", t, nOp*nProc);
+}
+
+static const struct {
+  const char *zName;
+  void (*xBench)(void);
+} aBench[] = {
+  { "btree-point-lookup",    benchPointLookup },
+  { "vdbe-aggregate-scan",   benchVdbeScan },
+  { "wal-autocommit-insert", benchWalCommit },
+  { "sorter-order-by",       benchSorter },
+  { "json-extract",          benchJson },
+  { "wal-contention-4proc",  benchWalContention },
+};
+
+int main(int argc, char **argv){
+  const char *zMatch = 0;
+  int i, n;
+  for(i=1; i<argc; i++){
+    if( strcmp(argv[i], "-scale")==0 && i+1<argc ){
+      giScale = atoi(argv[++i]);
+      if( giScale<1 ) giScale = 1;
+    }else{
+      zMatch = argv[i];
+    }
+  }
+  printf("SQLite %s (%s)\n", sqlite3_libversion(), sqlite3_sourceid());
+  for(n=0; n<(int)(sizeof(aBench)/sizeof(aBench[0])); n++){
+    if( zMatch && strncmp(aBench[n].zName, zMatch, strlen(zMatch)) ) continue;
+    gSeed = 0x2fab1e;
+    aBench[n].xBench();
+  }
+  return 0;
+}
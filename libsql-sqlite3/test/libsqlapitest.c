@@ -0,0 +1,194 @@
+/*
+** 2026-09-02
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+** Test harness for the libsql C-level APIs that the TCL test suite
+** cannot reach: the per-connection statement cache
+** (libsql_prepare_cached / libsql_release_cached_stmt) and the batched
+** execution entry point (libsql_stmt_exec_batch), plus the loadable
+** modules in ext/misc that ship with this tree (columnar, zonemap).
+**
+** Build and run with:
+**
+**     make libsqlapitest
+**
+** Prints one line per test group and "ALL-OK" on success; exits
+** non-zero on the first failure.
+*/
+#include "sqlite3.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define CHECK(x) \
+  if( !(x) ){ fprintf(stderr, "FAIL at %s:%d: %s\n", __FILE__, __LINE__, #x); return 1; }
+
+int libsql_prepare_cached(sqlite3*, const char*, int, sqlite3_stmt**);
+int libsql_release_cached_stmt(sqlite3_stmt*);
+int libsql_stmt_exec_batch(sqlite3_stmt*, int,
+                           int (*)(void*,sqlite3_stmt*,int), void*);
+int sqlite3_columnar_init(sqlite3*, char**, const sqlite3_api_routines*);
+int sqlite3_zonemap_init(sqlite3*, char**, const sqlite3_api_routines*);
+
+/* libsql_prepare_cached(): identical text returns the cached handle,
+** nByte is an upper bound that may exceed the cached allocation, and
+** distinct statements stay distinct. */
+static int test_prepare_cached(void){
+  sqlite3 *db;
+  sqlite3_stmt *p1, *p2, *p3;
+  CHECK( sqlite3_open(":memory:", &db)==SQLITE_OK );
+  CHECK( sqlite3_exec(db, "CREATE TABLE t(x)", 0, 0, 0)==SQLITE_OK );
+
+  CHECK( libsql_prepare_cached(db, "SELECT 1", -1, &p1)==SQLITE_OK );
+  CHECK( libsql_release_cached_stmt(p1)==SQLITE_OK );
+  CHECK( libsql_prepare_cached(db, "SELECT 1", -1, &p2)==SQLITE_OK );
+  CHECK( p2==p1 );    /* cache hit */
+  CHECK( libsql_release_cached_stmt(p2)==SQLITE_OK );
+
+  /* nByte beyond the cached text length is a legal upper bound */
+  CHECK( libsql_prepare_cached(db, "SELECT 1", 100, &p2)==SQLITE_OK );
+  CHECK( p2==p1 );
+  CHECK( libsql_release_cached_stmt(p2)==SQLITE_OK );
+
+  /* prefix-bounded lookup */
+  CHECK( libsql_prepare_cached(db, "SELECT 1 /*tail*/", 8, &p2)==SQLITE_OK );
+  CHECK( p2==p1 );
+  CHECK( libsql_release_cached_stmt(p2)==SQLITE_OK );
+
+  /* text diverging at the cached NUL is a different statement */
+  CHECK( libsql_prepare_cached(db, "SELECT 12", -1, &p3)==SQLITE_OK );
+  CHECK( p3!=p1 );
+  CHECK( libsql_release_cached_stmt(p3)==SQLITE_OK );
+
+  /* a cached statement comes back reset and usable */
+  CHECK( libsql_prepare_cached(db, "SELECT 1", -1, &p1)==SQLITE_OK );
+  CHECK( sqlite3_step(p1)==SQLITE_ROW );
+  CHECK( sqlite3_column_int(p1, 0)==1 );
+  CHECK( libsql_release_cached_stmt(p1)==SQLITE_OK );
+
+  CHECK( sqlite3_close(db)==SQLITE_OK );
+  printf("prepare_cached: ok\n");
+  return 0;
+}
+
+static int batchBind(void *pArg, sqlite3_stmt *pStmt, int iIter){
+  (void)pArg;
+  return sqlite3_bind_int(pStmt, 1, iIter);
+}
+
+/* libsql_stmt_exec_batch(): N iterations with a bind callback behave
+** like N bind/step/reset loops. */
+static int test_exec_batch(void){
+  sqlite3 *db;
+  sqlite3_stmt *p;
+  int rc;
+  CHECK( sqlite3_open(":memory:", &db)==SQLITE_OK );
+  CHECK( sqlite3_exec(db, "CREATE TABLE t(x)", 0, 0, 0)==SQLITE_OK );
+  CHECK( sqlite3_prepare_v2(db, "INSERT INTO t VALUES(?1)", -1, &p, 0)==SQLITE_OK );
+  CHECK( libsql_stmt_exec_batch(p, 1000, batchBind, 0)==SQLITE_OK );
+  sqlite3_finalize(p);
+
+  CHECK( sqlite3_prepare_v2(db,
+      "SELECT count(*), min(x), max(x) FROM t", -1, &p, 0)==SQLITE_OK );
+  CHECK( sqlite3_step(p)==SQLITE_ROW );
+  CHECK( sqlite3_column_int(p, 0)==1000 );
+  CHECK( sqlite3_column_int(p, 1)==0 );
+  CHECK( sqlite3_column_int(p, 2)==999 );
+  sqlite3_finalize(p);
+
+  /* without a bind callback the statement just runs nIter times */
+  CHECK( sqlite3_prepare_v2(db, "INSERT INTO t VALUES(-1)", -1, &p, 0)==SQLITE_OK );
+  CHECK( libsql_stmt_exec_batch(p, 5, 0, 0)==SQLITE_OK );
+  sqlite3_finalize(p);
+  CHECK( sqlite3_prepare_v2(db,
+      "SELECT count(*) FROM t WHERE x=-1", -1, &p, 0)==SQLITE_OK );
+  CHECK( sqlite3_step(p)==SQLITE_ROW );
+  CHECK( sqlite3_column_int(p, 0)==5 );
+  sqlite3_finalize(p);
+
+  /* a constraint failure stops the batch and reports the error */
+  CHECK( sqlite3_exec(db,
+      "CREATE TABLE u(k INTEGER PRIMARY KEY); INSERT INTO u VALUES(3);",
+      0, 0, 0)==SQLITE_OK );
+  CHECK( sqlite3_prepare_v2(db, "INSERT INTO u VALUES(?1)", -1, &p, 0)==SQLITE_OK );
+  rc = libsql_stmt_exec_batch(p, 10, batchBind, 0);
+  CHECK( rc==SQLITE_CONSTRAINT );
+  sqlite3_finalize(p);
+
+  CHECK( sqlite3_close(db)==SQLITE_OK );
+  printf("exec_batch: ok\n");
+  return 0;
+}
+
+/* The columnar shadow module: totals match the rowstore. */
+static int test_columnar(void){
+  sqlite3 *db;
+  sqlite3_stmt *p;
+  CHECK( sqlite3_open(":memory:", &db)==SQLITE_OK );
+  CHECK( sqlite3_columnar_init(db, 0, 0)==SQLITE_OK );
+  CHECK( sqlite3_exec(db,
+      "CREATE TABLE src(a INTEGER, b TEXT, c REAL);"
+      "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i+1 FROM n WHERE i<9000)"
+      "  INSERT INTO src SELECT i, 'row'||i, i*0.5 FROM n;"
+      "CREATE VIRTUAL TABLE cs USING columnar(src);",
+      0, 0, 0)==SQLITE_OK );
+  CHECK( sqlite3_prepare_v2(db,
+      "SELECT (SELECT sum(a) FROM cs)==(SELECT sum(a) FROM src),"
+      "       (SELECT count(*) FROM cs WHERE b='row777'),"
+      "       (SELECT sum(c) FROM cs)==(SELECT sum(c) FROM src)",
+      -1, &p, 0)==SQLITE_OK );
+  CHECK( sqlite3_step(p)==SQLITE_ROW );
+  CHECK( sqlite3_column_int(p, 0)==1 );
+  CHECK( sqlite3_column_int(p, 1)==1 );
+  CHECK( sqlite3_column_int(p, 2)==1 );
+  sqlite3_finalize(p);
+  CHECK( sqlite3_close(db)==SQLITE_OK );
+  printf("columnar: ok\n");
+  return 0;
+}
+
+/* The zonemap module: zone pruning returns exactly the rows a full
+** scan does. */
+static int test_zonemap(void){
+  sqlite3 *db;
+  sqlite3_stmt *p;
+  CHECK( sqlite3_open(":memory:", &db)==SQLITE_OK );
+  CHECK( sqlite3_zonemap_init(db, 0, 0)==SQLITE_OK );
+  CHECK( sqlite3_exec(db,
+      "CREATE TABLE ev(ts INTEGER, v TEXT);"
+      "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i+1 FROM n WHERE i<20000)"
+      "  INSERT INTO ev SELECT i*10, 'v'||i FROM n;"
+      "CREATE VIRTUAL TABLE zm USING zonemap(ev, ts, 1024);",
+      0, 0, 0)==SQLITE_OK );
+  CHECK( sqlite3_prepare_v2(db,
+      "SELECT (SELECT count(*) FROM zm JOIN ev s"
+      "          ON s.rowid BETWEEN zm.minrow AND zm.maxrow"
+      "        WHERE zm.maxv>=50000 AND zm.minv<=51000"
+      "          AND s.ts BETWEEN 50000 AND 51000)"
+      "     = (SELECT count(*) FROM ev WHERE ts BETWEEN 50000 AND 51000),"
+      "       (SELECT count(*) FROM zm)",
+      -1, &p, 0)==SQLITE_OK );
+  CHECK( sqlite3_step(p)==SQLITE_ROW );
+  CHECK( sqlite3_column_int(p, 0)==1 );
+  CHECK( sqlite3_column_int(p, 1)==(20000+1023)/1024 );
+  sqlite3_finalize(p);
+  CHECK( sqlite3_close(db)==SQLITE_OK );
+  printf("zonemap: ok\n");
+  return 0;
+}
+
+int main(void){
+  if( test_prepare_cached() ) return 1;
+  if( test_exec_batch() ) return 1;
+  if( test_columnar() ) return 1;
+  if( test_zonemap() ) return 1;
+  printf("ALL-OK\n");
+  return 0;
+}
@@ -125,6 +125,7 @@ set boolean_defnil_options {
   SQLITE_ENABLE_ATOMIC_WRITE
   SQLITE_ENABLE_BATCH_ATOMIC_WRITE
   SQLITE_ENABLE_BYTECODE_VTAB
+  SQLITE_ENABLE_CLOCK_PCACHE
   SQLITE_ENABLE_COLUMN_METADATA
   SQLITE_ENABLE_COLUMN_USED_MASK
   SQLITE_ENABLE_COSTMULT
@@ -142,6 +143,7 @@ set boolean_defnil_options {
   SQLITE_ENABLE_HIDDEN_COLUMNS
   SQLITE_ENABLE_ICU
   SQLITE_ENABLE_IOTRACE
+  SQLITE_ENABLE_IOURING
   SQLITE_ENABLE_LOAD_EXTENSION
   SQLITE_ENABLE_LOCKING_STYLE
   SQLITE_ENABLE_MATH_FUNCTIONS
@@ -164,12 +166,14 @@ set boolean_defnil_options {
   SQLITE_ENABLE_STAT4
   SQLITE_ENABLE_STMT_SCANSTATUS
   SQLITE_ENABLE_STMTVTAB
+  SQLITE_ENABLE_SUPERINSTRUCTIONS
   SQLITE_ENABLE_TREETRACE
   SQLITE_ENABLE_UNKNOWN_SQL_FUNCTION
   SQLITE_ENABLE_UNLOCK_NOTIFY
   SQLITE_ENABLE_UPDATE_DELETE_LIMIT
   SQLITE_ENABLE_URI_00_ERROR
   SQLITE_ENABLE_VFSTRACE
+  SQLITE_ENABLE_WAL_COMPRESSION
   SQLITE_ENABLE_WHERETRACE
   SQLITE_ENABLE_ZIPVFS
   SQLITE_EXPLAIN_ESTIMATED_ROWS
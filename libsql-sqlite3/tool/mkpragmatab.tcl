@@ -51,6 +51,21 @@ set pragma_def {
   ARG:  SQLITE_CkptFullFSync
   IF:   !defined(SQLITE_OMIT_FLAG_PRAGMAS)
 
+  NAME: wal_group_commit
+  TYPE: FLAG
+  ARG:  SQLITE_GroupCommit
+  IF:   !defined(SQLITE_OMIT_FLAG_PRAGMAS) && !defined(SQLITE_OMIT_WAL)
+
+  NAME: concurrent_writes
+  TYPE: FLAG
+  ARG:  SQLITE_ConcurrentWr
+  IF:   !defined(SQLITE_OMIT_FLAG_PRAGMAS) && !defined(SQLITE_OMIT_WAL)
+
+  NAME: wal_compression
+  TYPE: FLAG
+  ARG:  SQLITE_WalCompress
+  IF:   !defined(SQLITE_OMIT_FLAG_PRAGMAS) && defined(SQLITE_ENABLE_WAL_COMPRESSION)
+
   NAME: cache_spill
   FLAG: Result0 SchemaReq NoColumns1
   IF:   !defined(SQLITE_OMIT_FLAG_PRAGMAS)
@@ -391,6 +406,18 @@ set pragma_def {
   NAME: analysis_limit
   FLAG: Result0
 
+  NAME: autovacuum_pages
+  FLAG: Result0
+  IF:   !defined(SQLITE_OMIT_AUTOVACUUM)
+
+  NAME: checkpoint_workers
+  FLAG: Result0
+  IF:   !defined(SQLITE_OMIT_WAL)
+
+  NAME: analyze_incremental
+  FLAG: NeedSchema NoColumns1
+  IF:   !defined(SQLITE_OMIT_ANALYZE)
+
   NAME: optimize
   FLAG: Result1 NeedSchema
 